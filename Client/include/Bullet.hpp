@@ -6,8 +6,11 @@
 #include "PileAA/DynamicEntity.hpp"
 #include "PileAA/Math.hpp"
 #include <PileAA/Types.hpp>
+#include <array>
 #include <cmath>
 #include <functional>
+#include <mutex>
+#include <vector>
 
 namespace paa {
 class CollisionBox;
@@ -60,6 +63,12 @@ namespace game {
 
         virtual void update() = 0;
         virtual void on_collision(const paa::CollisionBox& other);
+
+        /**
+         * @brief Copies the bullet, with its life timer
+         *        (a rollback restores the copy, see SILVA_DEEP_CLONE)
+         */
+        virtual std::shared_ptr<ABullet> clone() const = 0;
     };
 
     using Bullet = std::shared_ptr<ABullet>;
@@ -71,6 +80,7 @@ namespace game {
         BasicBullet(
             const PAA_ENTITY& e, const double& aim_angle, bool from_player);
         void update() override;
+        Bullet clone() const override { return paa::make_pooled<BasicBullet>(*this); }
     };
 
     class SkeletonBullet : public ABullet {
@@ -81,6 +91,8 @@ namespace game {
             const PAA_ENTITY&e, const double &aim_angle, bool from_player);
 
         void update() override;
+
+        Bullet clone() const override { return paa::make_pooled<SkeletonBullet>(*this); }
     };
 
     class MattisBullet : public ABullet {
@@ -90,6 +102,7 @@ namespace game {
         MattisBullet(const PAA_ENTITY& e,
                 const double& aim_angle, bool from_player);
         void update() override;
+        Bullet clone() const override { return paa::make_pooled<MattisBullet>(*this); }
     };
 
     class LaserBeam : public ABullet {
@@ -99,6 +112,7 @@ namespace game {
         LaserBeam(const PAA_ENTITY& e,
                 const double& aim_angle, bool from_player);
         void update() override;
+        Bullet clone() const override { return paa::make_pooled<LaserBeam>(*this); }
     };
 
     class MissileBullet : public ABullet {
@@ -109,6 +123,8 @@ namespace game {
                 const PAA_ENTITY&e, const double &aim_angle, bool from_player);
 
             void update() override;
+
+            Bullet clone() const override { return paa::make_pooled<MissileBullet>(*this); }
     };
 
     class BulletFactory {
@@ -116,13 +132,35 @@ namespace game {
         template <typename B, typename... Args>
         static inline Bullet make_bullet(Args&&... args)
         {
-            return std::make_shared<B>(std::forward<Args>(args)...);
+            return paa::make_pooled<B>(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Registers the prefabs of the bullets
+         *        (once the resources and the animations are loaded)
+         */
+        static void register_prefabs();
+
+        static const paa::Prefab& get_explosion_prefab()
+        {
+            return *_explosion_prefab;
         }
 
+        /**
+         * @brief Shoots a bullet, it is spawned by spawn_shot_bullets
+         *        (the enemy system runs on the workers and cannot spawn)
+         */
         static void make_bullet_by_type(
-            const std::string& bullet_type, paa::Position const& ref,
+            const BulletType bullet_type, paa::Position const& ref,
             const bool& from_player, float aim);
 
+        /**
+         * @brief Spawns the bullets shot since the last call in the order
+         *        they were shot, the entities are the same on every client
+         *        in lockstep (must be called from an exclusive system)
+         */
+        static void spawn_shot_bullets();
+
         static void make_skeleton_bullet(
             float aim_angle, paa::Position const& posRef, const bool& from_player);
 
@@ -138,13 +176,19 @@ namespace game {
         static void make_missile_bullet(float aim_angle,
             paa::Position const& posRef, const bool& from_player);
     private:
-        static inline std::unordered_map<std::string, std::function<void(float, paa::Position const&, const bool&)>> _matching_type = {
-            {"basic_bullet", &make_basic_bullet},
-            {"skeleton_bullet", &make_skeleton_bullet},
-            {"mattis_bullet", &make_mattis_bullet},
-            {"laser_beam", &make_laser_beam},
-            {"missile_bullet", &make_missile_bullet}
+        static inline std::array<const paa::Prefab*, MISSILE_BULLET + 1>
+            _prefabs = {};
+        static inline const paa::Prefab* _explosion_prefab = nullptr;
+
+        struct Shot {
+            BulletType type;
+            paa::Position position;
+            bool from_player;
+            float aim;
         };
+
+        static inline std::vector<Shot> _shots;
+        static inline std::mutex _shots_mutex;
     };
 
     class BulletExplosion {
@@ -155,9 +199,9 @@ namespace game {
     public:
         BulletExplosion(const PAA_ENTITY& e)
             : _e(e)
-            , _s(paa::DynamicEntity(e).attachSprite("basic_bullet"))
+            , _s(paa::DynamicEntity(e).attachSprite(
+                  BulletFactory::get_explosion_prefab()))
         {
-            _s->useAnimation("explosion");
         }
 
         ~BulletExplosion() = default;
@@ -173,3 +217,6 @@ namespace game {
 }
 
 /// Bullets
+
+// The bullets are copied when the registry is saved (see ABullet::clone)
+SILVA_DEEP_CLONE(rtype::game::Bullet);
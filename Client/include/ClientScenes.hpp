@@ -6,6 +6,7 @@
 #include "PileAA/GUI.hpp"
 #include "PileAA/Rand.hpp"
 #include "RServer/Client/Client.hpp"
+#include "RServer/Messages/BitStream.hpp"
 #include "BlackScreenTransition.hpp"
 #include "utils.hpp"
 #include <spdlog/spdlog.h>
@@ -68,6 +69,10 @@ struct Game {
     float scroll = 0;
     bool lock_scroll = false;
     bool show_gui = true;
+
+    // Input delay (in ticks) of the lockstep mode, 0 if the players
+    // send their state instead (see GameLauncher)
+    rtype::net::Byte lockstep_delay = 0;
 };
 
 extern Game g_game;
@@ -92,19 +97,21 @@ public:
         : _element(element)
     {
     }
+    // Ids and scroll values are small, a varint keeps them on 1 to 3 bytes
     std::vector<rtype::net::Byte> serialize() const override
     {
-        rtype::net::Serializer serializer;
-        serializer << _element;
-        return serializer.data;
+        rtype::net::bit_writer writer;
+        rtype::net::bits::varint().write(writer, _element);
+        return writer.data();
     }
     void from(const rtype::net::Byte* data,
         const rtype::net::BufferSizeType size) override
     {
-        rtype::net::Serializer serializer(data, size);
-        serializer >> _element;
+        rtype::net::bit_reader reader(data, size);
+        _element = rtype::net::bits::varint().read<T>(reader);
     }
     T& getElement() { return (_element); }
+    const T& getElement() const { return (_element); }
 };
 
 class SerializedEnemyDeath : public DestroyableElementSerializer<paa::u16> {
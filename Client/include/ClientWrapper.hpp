@@ -33,6 +33,7 @@ namespace game {
 
         rtype::net::TCPClient& tcp() { return client->tcp(); }
         rtype::net::UDPClient& udp() { return client->udp(); }
+        rtype::net::inbox& inbox() { return client->get_inbox(); }
 
         std::string host = "127.0.0.1";
         rtype::net::PortType tcp_port = 4242;
@@ -26,8 +26,8 @@ namespace game {
             const paa::CollisionBox::callback_t& callback, const int64_t& id,
             const PAA_ENTITY& entity)
         {
-            return paa::SCollisionBox(
-                new paa::CollisionBox(rect, callback, id, entity));
+            return paa::make_pooled<paa::CollisionBox>(
+                rect, callback, id, entity);
         }
 
         static paa::SCollisionBox makePlayerCollision(
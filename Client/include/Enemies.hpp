@@ -2,6 +2,7 @@
 #include "PileAA/DynamicEntity.hpp"
 #include "Shooter.hpp"
 #include "Bullet.hpp"
+#include <array>
 
 namespace rtype {
 namespace game {
@@ -40,6 +41,22 @@ namespace game {
 
         virtual void update() = 0;
         virtual void on_collision(const paa::CollisionBox& other);
+
+        /**
+         * @brief Copies the enemy, with its timers and its shooters
+         *        (a rollback restores the copy, see SILVA_DEEP_CLONE)
+         */
+        virtual std::shared_ptr<AEnemy> clone() const = 0;
+
+    protected:
+        template <typename T> std::shared_ptr<AEnemy> clone_as() const
+        {
+            std::shared_ptr<AEnemy> copy
+                = paa::make_pooled<T>(static_cast<const T&>(*this));
+
+            copy->_shooterList = clone_shooters(_shooterList);
+            return copy;
+        }
     };
 
     class BasicEnemy : public AEnemy {
@@ -54,6 +71,8 @@ namespace game {
         ~BasicEnemy() = default;
 
         void update() override;
+
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<BasicEnemy>(); }
     };
 
     class KeyEnemy : public AEnemy {
@@ -68,6 +87,8 @@ namespace game {
         ~KeyEnemy() = default;
 
         void update() override;
+
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<KeyEnemy>(); }
     };
 
     class MastodonteEnemy : public AEnemy {
@@ -76,6 +97,8 @@ namespace game {
         ~MastodonteEnemy() = default;
 
         void update() override;
+
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<MastodonteEnemy>(); }
     };
 
     class DumbyBoy : public AEnemy {
@@ -91,6 +114,7 @@ namespace game {
 
         void on_collision(const paa::CollisionBox& other) override;
         void update() override;
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<DumbyBoy>(); }
     };
 
     class SkeletonBoss : public AEnemy {
@@ -99,6 +123,8 @@ namespace game {
         ~SkeletonBoss() = default;
 
         void update() override;
+
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<SkeletonBoss>(); }
     };
 
     class SkeletonBossHead : public AEnemy {
@@ -121,6 +147,7 @@ namespace game {
 
         void on_collision(const paa::CollisionBox& other) override;
         void update() override;
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<SkeletonBossHead>(); }
 
     private:
         void delay_shoot();
@@ -136,6 +163,8 @@ namespace game {
         void update() override;
         void on_collision(const paa::CollisionBox& other) override;
 
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<Mattis>(); }
+
     private:
         void shoot_sequence(
                 const float& deltaTime, const paa::Position& pos);
@@ -156,7 +185,9 @@ namespace game {
         float _current_shoot_duration = 0.0f;
         float _red_timer = 0.0f;
         PAA_ENTITY _mouth;
-        paa::Sound _laser = paa::Sound(PAA_RESOURCE_MANAGER.get<paa::SoundBuffer>("laser_sound"));
+        // Shared with the copies of the enemy
+        std::shared_ptr<paa::Sound> _laser = std::make_shared<paa::Sound>(
+            PAA_RESOURCE_MANAGER.get<paa::SoundBuffer>("laser_sound"));
     };
 
     class MattisMouth : public AEnemy {
@@ -167,6 +198,8 @@ namespace game {
 
         void update() override;
 
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<MattisMouth>(); }
+
     private:
         void open_mouth(paa::Position& mouth_pos,
                 const float& deltaTime);
@@ -176,8 +209,9 @@ namespace game {
                 paa::Position const& pos);
 
     private:
-        paa::Sound _ghast =
-            paa::Sound(PAA_RESOURCE_MANAGER.get<paa::SoundBuffer>("ghast_sound"));
+        // Shared with the copies of the enemy
+        std::shared_ptr<paa::Sound> _ghast = std::make_shared<paa::Sound>(
+            PAA_RESOURCE_MANAGER.get<paa::SoundBuffer>("ghast_sound"));
         std::size_t _shoot_index = 0;
         float _y_offset = 0.0f;
         paa::Position _last_mouth_pos;
@@ -230,6 +264,8 @@ namespace game {
 
         void update() override;
 
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<CentipedeBody>(); }
+
         void heal_self_and_child();
     };
 
@@ -269,6 +305,8 @@ namespace game {
         CentipedeBack get_back();
 
         void update() override;
+
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<Centipede>(); }
     };
 
     //class RobotBoss : public AEnemy {
@@ -303,15 +341,54 @@ namespace game {
         bool is_alive() override;
         void on_collision(const paa::CollisionBox& other) override;
         void update() override;
+        std::shared_ptr<AEnemy> clone() const override { return clone_as<RobotBossEye>(); }
     };
 
     using Enemy = std::shared_ptr<AEnemy>;
     class EnemyFactory {
     public:
+        using creator_t = PAA_ENTITY (*)(double const& x, double const& y);
+
+        enum PrefabId {
+            BASIC_ENEMY_PREFAB,
+            KEY_ENEMY_PREFAB,
+            MASTODONTE_ENEMY_PREFAB,
+            DUMBY_BOY_ENEMY_PREFAB,
+            SKELETON_BOSS_PREFAB,
+            SKELETON_BOSS_HEAD_PREFAB,
+            MATTIS_BOSS_FACE_PREFAB,
+            MATTIS_BOSS_MOUTH_PREFAB,
+            CENTIPEDE_HEAD_PREFAB,
+            CENTIPEDE_BODY_PREFAB,
+            ROBOT_BOSS_EYE_PREFAB,
+            ROBOT_BOSS_BODY_PREFAB,
+            ROBOT_BOSS_UP_BOOSTER_PREFAB,
+            ROBOT_BOSS_DOWN_BOOSTER_PREFAB,
+            ROBOT_BOSS_WEAPON_PREFAB,
+            PREFAB_COUNT
+        };
+
+        /**
+         * @brief Registers the prefabs of the enemies
+         *        (once the resources and the animations are loaded)
+         */
+        static void register_prefabs();
+
+        static const paa::Prefab& get_prefab(PrefabId id)
+        {
+            return *_prefabs[id];
+        }
+
+        /**
+         * @brief Get the factory of a type of enemy (to look it up once,
+         *        when the map is loaded), throws if the type is unknown
+         */
+        static creator_t get_creator(const std::string& enemy_type);
+
         template <typename T, typename... Args>
         static Enemy make_enemy(Args&&... args)
         {
-            return std::make_shared<T>(std::forward<Args>(args)...);
+            return paa::make_pooled<T>(std::forward<Args>(args)...);
         }
 
         static PAA_ENTITY make_basic_enemy(double const& x, double const& y);
@@ -341,6 +418,13 @@ namespace game {
         static PAA_ENTITY make_robot_boss(
             double const& x, double const& y
         );
+
+    private:
+        static inline std::array<const paa::Prefab*, PREFAB_COUNT> _prefabs
+            = {};
     };
 }
 }
+
+// The enemies are copied when the registry is saved (see AEnemy::clone)
+SILVA_DEEP_CLONE(rtype::game::Enemy);
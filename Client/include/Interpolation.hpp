@@ -0,0 +1,86 @@
+#pragma once
+
+#include "PileAA/BaseComponents.hpp"
+
+#include <chrono>
+#include <deque>
+
+namespace rtype {
+namespace game {
+
+    /**
+     * @brief Timestamped states of a remote entity
+     *
+     *        The entity is rendered a little in the past, between the two
+     *        states that surround the render time, so it moves smoothly even
+     *        if the states are rare or arrive irregularly
+     *        The delay follows the interval between the states and its
+     *        jitter, when the newest state is too old the motion is
+     *        extrapolated for a short time
+     */
+    class InterpolationBuffer {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        // Bounds of the render delay (in seconds)
+        static constexpr double MIN_DELAY = 0.05;
+        static constexpr double MAX_DELAY = 0.5;
+
+        // Longest extrapolation past the newest state (in seconds)
+        static constexpr double MAX_EXTRAPOLATION = 0.1;
+
+        // A longer gap between two states is a pause of the sender (nothing
+        // changed) and not jitter
+        static constexpr double MAX_INTERVAL = 0.5;
+
+        static constexpr std::size_t SIZE = 32;
+
+        /**
+         * @param delay Delay added to the one computed from the jitter
+         *        (in seconds)
+         */
+        InterpolationBuffer(double delay = 0.02);
+        ~InterpolationBuffer() = default;
+
+        /**
+         * @brief Adds a received state
+         *
+         * @param position The position of the entity
+         * @param moving Whether the entity was moving (only a moving entity
+         *        is extrapolated)
+         * @param now The reception time
+         */
+        void push(const paa::Vec2& position, bool moving,
+            clock::time_point now = clock::now());
+
+        /**
+         * @brief Gets the position to render now
+         */
+        paa::Vec2 sample(clock::time_point now = clock::now()) const;
+
+        /**
+         * @brief The current render delay (in seconds)
+         */
+        double delay() const;
+
+        bool empty() const { return _states.empty(); }
+
+        void clear();
+
+    private:
+        struct State {
+            double time;
+            paa::Vec2 position;
+            bool moving;
+        };
+
+        static double seconds(clock::time_point time);
+
+        std::deque<State> _states;
+        double _delay;
+        double _interval = 0.1;
+        double _jitter = 0;
+    };
+
+}
+}
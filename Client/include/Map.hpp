@@ -5,6 +5,12 @@
 #include <unordered_map>
 #include <vector>
 
+namespace hl {
+namespace silva {
+    class Entity;
+}
+}
+
 namespace rtype {
 namespace game {
 
@@ -43,13 +49,18 @@ namespace game {
     class Wave {
     public:
         struct WaveData {
+            using creator_t = hl::silva::Entity (*)(
+                double const& x, double const& y);
+
             std::string enemy_type;
+            creator_t creator; // Looked up once, when the map is loaded
             uint64_t enemy_id;
             float x, y;
 
-            WaveData(const std::string& enemy_type, uint64_t enemy_id, float x,
-                float y)
+            WaveData(const std::string& enemy_type, creator_t creator,
+                uint64_t enemy_id, float x, float y)
                 : enemy_type(enemy_type)
+                , creator(creator)
                 , enemy_id(enemy_id)
                 , x(x)
                 , y(y)
@@ -86,7 +97,19 @@ namespace game {
     private:
         WaveManager _waves;
         EffectZones _zones;
-        bool _changes = false;
+
+    public:
+        /**
+         * @brief  The effects the map applied so far (a lockstep rollback
+         *         puts back the progress of the tick it loads)
+         */
+        struct Progress {
+            std::vector<bool> applied; // By effect zone
+            bool changes = false;
+        };
+
+    private:
+        Progress _progress;
 
         /**
          * @brief  Parse the map info and generates entities to match it
@@ -109,6 +132,10 @@ namespace game {
         void update();
 
         bool changes();
+
+        const Progress& progress() const { return _progress; }
+
+        void restore(const Progress& progress) { _progress = progress; }
     };
 
 }
@@ -3,6 +3,10 @@
 #include "Collisions.hpp"
 #include "PileAA/DynamicEntity.hpp"
 #include "PileAA/Rand.hpp"
+#include "Interpolation.hpp"
+#include "Prediction.hpp"
+#include "RServer/Feed/InputHistory.hpp"
+#include "RServer/Feed/Snapshot.hpp"
 #include "RServer/Messages/Types.hpp"
 #include "Shooter.hpp"
 
@@ -15,7 +19,7 @@
 namespace rtype {
 namespace game {
 
-    class SerializablePlayer : public net::Serializable {
+    class SerializablePlayer : public net::player_state {
     public:
         using mask_t = uint8_t;
         using data_t = uint8_t;
@@ -38,8 +42,8 @@ namespace game {
         static constexpr mask_t HEALTH_MASK         = 0b11100000;
         static constexpr mask_t HEALTH_SHIFT        = 0x5;
 
-        data_t data = 0x0;
-        net::vector2i pos;
+        // Bits that only depend on the controller
+        static constexpr mask_t INPUT_MASK          = 0b00011111;
 
         SerializablePlayer() = default;
         SerializablePlayer(const SerializablePlayer& other) = default;
@@ -52,17 +56,18 @@ namespace game {
             const paa::Position& position, const paa::Health& health,
             const paa::Id& id);
 
-        std::vector<net::Byte> serialize() const override;
-
-        void from(
-            const net::Byte* data, const net::BufferSizeType size) override;
-
         void set_from_components(const paa::Controller& controller,
             const paa::Position& pos, const paa::Health& health,
             const paa::Id& id);
 
         void set_from_entity(const PAA_ENTITY& e);
 
+        // Sets the move and shoot bits from the state of the controller
+        SerializablePlayer& set_input(const paa::Controller& controller);
+
+        // Makes a simulated controller reproduce the move and shoot bits
+        void simulate_input(paa::Controller& controller) const;
+
         SerializablePlayer& set_bdata(const bool& value, mask_t mask);
 
         SerializablePlayer& set_move_left(bool value);
@@ -98,11 +103,15 @@ namespace game {
         ShooterList _shooterList;
 
         SerializablePlayer _info;
+        net::snapshot_encoder<SerializablePlayer> _snapshots;
+        net::input_history _inputs;
+        PredictionHistory _prediction;
+        InterpolationBuffer _interpolation;
 
         bool _wallDeath;
         paa::Timer _wallDeathTimer;
-        paa::Timer _syncWithTcpTimer;
         paa::Timer _syncTimer;
+        paa::Timer _rateTimer;
         paa::Timer _hurtTimer;
         paa::Timer _frameTimer;
         paa::Timer _yFrameUpdate;
@@ -113,6 +122,9 @@ namespace game {
 
         bool _is_hurt = false;
 
+        // A shot of a remote player was only found in the input history
+        bool _missed_shot = false;
+
         bool _clamp_position = true;
 
         int _speed_x;
@@ -124,14 +136,14 @@ namespace game {
 
         int _y_frame = 0;
 
-        paa::Sound _hurt_sound =
-            paa::Sound(PAA_RESOURCE_MANAGER.get<paa::SoundBuffer>("player_hurt"));
+        // Shared with the copies of the player
+        std::shared_ptr<paa::Sound> _hurt_sound = std::make_shared<paa::Sound>(
+            PAA_RESOURCE_MANAGER.get<paa::SoundBuffer>("player_hurt"));
 
     public:
         static constexpr int WALL_DEATH_TIME = 500;
         static constexpr int MAX_HEALTH = 6;
         static constexpr int SYNC_RATE = 250;
-        static constexpr int SYNC_WITH_TCP_RATE = 2000;
         static constexpr int Y_FRAMES = 4;
         static constexpr int SPEED_X = 200;
         static constexpr int SPEED_Y = 150;
@@ -146,11 +158,15 @@ namespace game {
         ~APlayer() = default;
 
         void update_info(const SerializablePlayer& info);
+        void reconcile(const SerializablePlayer& info);
+        void replay_inputs(const std::vector<net::input_frame>& frames);
         void update_shoot();
         void update_data();
         void update_sprite_hurt();
         void use_frame();
         void update_position();
+        void update_interpolated_position();
+        void update_frame(float axis_y);
         void update();
         void set_clamp_position(bool clamp_position);
         void set_speed_x(int speed);
@@ -161,6 +177,13 @@ namespace game {
         void add_shooter(Shooter shooter);
         bool is_dead() const;
         bool is_local() const;
+        bool is_simulated() const;
+
+        /**
+         * @brief Copies the player, with its timers and its shooters
+         *        (a rollback restores the copy, see SILVA_DEEP_CLONE)
+         */
+        std::shared_ptr<APlayer> clone() const;
     };
 
     using Player = std::shared_ptr<APlayer>;
@@ -173,3 +196,6 @@ namespace game {
 
 }
 }
+
+// The players are copied when the registry is saved (see APlayer::clone)
+SILVA_DEEP_CLONE(rtype::game::Player);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "PileAA/BaseComponents.hpp"
+#include "RServer/Messages/Types.hpp"
+
+#include <deque>
+
+namespace rtype {
+namespace game {
+
+    /**
+     * @brief History of the moves of the local player
+     *
+     *        The local player moves as soon as an input is pressed, every
+     *        frame that moved it gets a new tick which is sent with its state
+     *        When the server sends back the position it computed for a tick,
+     *        the moves that followed that tick are replayed from it
+     */
+    class PredictionHistory {
+    public:
+        // Count of moves kept (must be lower than the range of a tick)
+        static constexpr std::size_t SIZE = 128;
+
+        // Under this distance (in pixels) the prediction is considered right,
+        // the positions are quantized on 2 pixels on the feed
+        static constexpr double THRESHOLD = 4;
+
+        struct Move {
+            net::player_tick_t tick = 0;
+            int dx = 0; // -1, 0 or 1
+            int dy = 0; // -1, 0 or 1
+            double dt = 0;
+            paa::Vec2 position; // Relative to the scroll, after the move
+        };
+
+        PredictionHistory() = default;
+        ~PredictionHistory() = default;
+
+        /**
+         * @brief Records the move of the current frame
+         *        Nothing is recorded if the player did not move
+         *
+         * @param dx The direction on x (-1, 0 or 1)
+         * @param dy The direction on y (-1, 0 or 1)
+         * @param dt The duration of the frame (in seconds)
+         * @param position The position after the move (relative to the scroll)
+         */
+        void record(int dx, int dy, double dt, const paa::Vec2& position);
+
+        /**
+         * @brief The tick of the last recorded move
+         */
+        net::player_tick_t tick() const { return _tick; }
+
+        /**
+         * @brief Replays the moves that follow a corrected tick
+         *
+         * @param tick The tick of the correction
+         * @param corrected The position computed by the server for this tick
+         * @param speed The speed of the player (in pixels per second)
+         * @param max The bottom right bound of the position
+         * @param position Set to the position after the replay
+         * @return true if the prediction was wrong and position must be used
+         */
+        bool reconcile(net::player_tick_t tick, const paa::Vec2& corrected,
+            const paa::Vec2& speed, const paa::Vec2& max, paa::Vec2& position);
+
+        void clear();
+
+    private:
+        std::deque<Move> _moves;
+        net::player_tick_t _tick = 0;
+    };
+
+}
+}
@@ -6,6 +6,10 @@
 namespace rtype {
 namespace game {
 
+    using bullet_type_t = uint8_t;
+
+    enum BulletType : bullet_type_t;
+
     class AShooter {
     protected:
         paa::Timer _timer;
@@ -23,24 +27,37 @@ namespace game {
         AShooter& aim(float const& aim_angle, bool isRadian = false);
         bool angle_is_set(void);
         bool is_attached_to_player() const;
-        void shoot_from_pos(std::string const& bullet_type,
+        void shoot_from_pos(BulletType bullet_type,
                 paa::Position const& position);
-        virtual void shoot(std::string const& bullet_type) = 0;
+        virtual void shoot(BulletType bullet_type) = 0;
+
+        /**
+         * @brief Copies the shooter, with its reload timer
+         *        (a rollback restores the copy, see SILVA_DEEP_CLONE)
+         */
+        virtual std::shared_ptr<AShooter> clone() const = 0;
     };
 
     using Shooter = std::shared_ptr<AShooter>;
 
     using ShooterList = std::vector<Shooter>;
 
+    /**
+     * @brief Copies every shooter of a list (see AShooter::clone)
+     */
+    ShooterList clone_shooters(const ShooterList& shooters);
+
     template <typename T, typename... Args>
     static inline Shooter make_shooter(Args&&... args)
     {
-        return std::make_shared<T>(std::forward<Args>(args)...);
+        return paa::make_pooled<T>(std::forward<Args>(args)...);
     }
 
     class BasicShooter : public AShooter {
     private:
-        paa::Sound _sound = paa::Sound(PAA_RESOURCE_MANAGER.get<paa::SoundBuffer>("laser_sound"));
+        // Shared with the copies of the shooter
+        std::shared_ptr<paa::Sound> _sound = std::make_shared<paa::Sound>(
+            PAA_RESOURCE_MANAGER.get<paa::SoundBuffer>("laser_sound"));
 
     public:
         BasicShooter(const PAA_ENTITY& e, double reloadTime = 900)
@@ -50,7 +67,8 @@ namespace game {
 
         ~BasicShooter() = default;
 
-        void shoot(std::string const& bullet_type) override final;
+        void shoot(BulletType bullet_type) override final;
+        Shooter clone() const override final;
     };
 
     class ConeShooter : public AShooter {
@@ -59,7 +77,8 @@ namespace game {
 
         ~ConeShooter() = default;
 
-        void shoot(std::string const& bullet_type) override final;
+        void shoot(BulletType bullet_type) override final;
+        Shooter clone() const override final;
 
     private:
         std::vector<Shooter> _shooterList;
@@ -14,25 +14,33 @@ Game g_game;
 
 static void register_bullet_system()
 {
-    PAA_REGISTER_SYSTEM([](hl::silva::registry& r) {
-        for (const auto&& [e, b] : r.view<rtype::game::Bullet>()) {
-            b->update();
-            if (!b->is_alive()) {
-                r.kill_entity(e);
-            }
-        }
-    });
+    // A bullet only moves itself
+    PAA_ECS.add_system([](hl::silva::registry& r) {
+        r.view<rtype::game::Bullet>().parallel_for(
+            [&r](hl::silva::registry::entity_id_t e, rtype::game::Bullet& b) {
+                b->update();
+                if (!b->is_alive()) {
+                    r.kill_entity(e);
+                }
+            });
+    }, hl::silva::reads<rtype::game::Bullet>(),
+        hl::silva::writes<paa::Position>());
 
-    PAA_REGISTER_SYSTEM([](hl::silva::registry& r) {
+    // Reads the frame of the explosions and kills the finished ones
+    PAA_ECS.add_system([](hl::silva::registry& r) {
         for (const auto&& [_, b] : r.view<rtype::game::BulletExplosion>()) {
             b.update();
         }
-    });
+    }, hl::silva::reads<paa::Sprite>(),
+        hl::silva::writes<rtype::game::BulletExplosion>());
 }
 
 static void register_enemy_system()
 {
-    PAA_REGISTER_SYSTEM([](hl::silva::registry& r) {
+    // The enemies move themselves and the parts of their boss, aim at the
+    // players and shoot (see BulletFactory::spawn_shot_bullets), Game
+    // stands for g_game and paa::Random for the seed they both draw from
+    PAA_ECS.add_system([](hl::silva::registry& r) {
         const auto view = PAA_SCREEN.getView();
         const double left_border = view.getCenter().x - view.getSize().x / 2 - 100;
         unsigned int count = 0;
@@ -49,7 +57,7 @@ static void register_enemy_system()
                 if (id.id != -1) {
                     g_game.enemies_to_entities.erase(id.id);
                     if (g_game.service.is_service_on())
-                        g_game.service.tcp().send(rtype::net::UpdateMessage(g_game.id,
+                        g_game.service.udp().send(rtype::net::UpdateMessage(g_game.id,
                             SerializedEnemyDeath(id.id),
                             rtype::net::message_code::UPDATE_ENEMY_DESTROYED));
                 }
@@ -60,7 +68,9 @@ static void register_enemy_system()
         if (count == 0 && g_game.lock_scroll) {
             g_game.lock_scroll = false;
         }
-    });
+    }, hl::silva::reads<paa::Id, rtype::game::Player>(),
+        hl::silva::writes<rtype::game::Enemy, paa::Position, paa::Health,
+            paa::Sprite, Game, paa::Random>());
 }
 
 static void register_player_system()
@@ -71,7 +81,7 @@ static void register_player_system()
             if (player->is_dead()) {
                 r.kill_entity(e);
                 if (g_game.service.is_service_on())
-                    g_game.service.tcp().send(rtype::net::UpdateMessage(g_game.id,
+                    g_game.service.udp().send(rtype::net::UpdateMessage(g_game.id,
                         SerializedPlayerDeath(id.id),
                         rtype::net::message_code::UPDATE_PLAYER_DESTROYED));
                 g_game.players_alive[id.id] = false;
@@ -80,6 +90,14 @@ static void register_player_system()
     });
 }
 
+static void register_shot_system()
+{
+    // Runs after every system that shoots
+    PAA_REGISTER_SYSTEM([](hl::silva::registry&) {
+        rtype::game::BulletFactory::spawn_shot_bullets();
+    });
+}
+
 PAA_MAIN("../Resources.conf", {
 
     // PAA_REGISTER_SCENE(test);
@@ -101,9 +119,12 @@ PAA_MAIN("../Resources.conf", {
         rtype::game::Player, rtype::game::EffectZones::EffectZoneData);
 
     rtype::game::RobotBossEye::register_robot_components();
+    rtype::game::BulletFactory::register_prefabs();
+    rtype::game::EnemyFactory::register_prefabs();
     register_bullet_system();
     register_enemy_system();
     register_player_system();
+    register_shot_system();
 
     g_game.hud_view = PAA_SCREEN.getView();
     g_game.reset_game_view();
@@ -35,9 +35,14 @@ namespace game {
 
         if (should_kill) {
             PAA_ECS.kill_entity(_e);
-            paa::DynamicEntity e = PAA_NEW_ENTITY();
-            e.emplaceComponent<BulletExplosion>(e);
-            e.attachPosition(get_position());
+            // Called while the collisions are checked, the explosion is
+            // spawned once the systems are done
+            PAA_ECS.commands().spawn(
+                [pos = get_position()](hl::silva::registry&, const PAA_ENTITY& entity) {
+                    paa::DynamicEntity e(entity);
+                    e.emplaceComponent<BulletExplosion>(e);
+                    e.attachPosition(pos);
+                });
         }
     }
 
@@ -122,121 +127,114 @@ namespace game {
         posRef.y += _dir.y * LASER_BEAM_SPEED * dt;
     }
 
+    void BulletFactory::register_prefabs()
+    {
+        auto& prefabs = PAA_PREFAB_REGISTER;
+
+        _prefabs[BASIC_BULLET] = &prefabs.addPrefab("basic_bullet",
+            paa::Prefab("basic_bullet", paa::Prefab::animation("base_animation")));
+        _prefabs[SKELETON_BULLET] = &prefabs.addPrefab("skeleton_bullet",
+            paa::Prefab("skeleton_bullet",
+                paa::Prefab::animation("skeleton_bullet_animation")));
+        _prefabs[MATTIS_BULLET] = &prefabs.addPrefab("mattis_bullet",
+            paa::Prefab("mattis_bullet",
+                paa::Prefab::animation("mattis_bullet_animation")));
+        _prefabs[LASER_BEAM] = &prefabs.addPrefab("laser_beam",
+            paa::Prefab("laser_beam",
+                paa::Prefab::animation("laser_beam_animation")));
+        _prefabs[MISSILE_BULLET] = &prefabs.addPrefab("missile_bullet",
+            paa::Prefab("robot_boss", paa::Prefab::animation("missile")));
+        _explosion_prefab = &prefabs.addPrefab("bullet_explosion",
+            paa::Prefab("basic_bullet", paa::Prefab::animation("explosion")));
+    }
+
     void BulletFactory::make_bullet_by_type(
-            const std::string& bullet_type, paa::Position const& ref,
+            const BulletType bullet_type, paa::Position const& ref,
             const bool& from_player, float aim)
     {
-        for (auto &iterator : _matching_type) {
-            if (iterator.first.compare(bullet_type) == 0)
-                iterator.second(aim, ref, from_player);
-        }
+        std::lock_guard<std::mutex> lock(_shots_mutex);
+
+        _shots.push_back({ bullet_type, ref, from_player, aim });
     }
 
-    void BulletFactory::make_basic_bullet(
-        float aim_angle, paa::Position const& posRef, const bool& from_player)
+    void BulletFactory::spawn_shot_bullets()
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
+        std::vector<Shot> shots;
+
+        {
+            std::lock_guard<std::mutex> lock(_shots_mutex);
+            shots.swap(_shots);
+        }
+        for (const Shot& shot : shots) {
+            switch (shot.type) {
+            case BASIC_BULLET:
+                make_basic_bullet(shot.aim, shot.position, shot.from_player);
+                break;
+            case SKELETON_BULLET:
+                make_skeleton_bullet(shot.aim, shot.position, shot.from_player);
+                break;
+            case MATTIS_BULLET:
+                make_mattis_bullet(shot.aim, shot.position, shot.from_player);
+                break;
+            case LASER_BEAM:
+                make_laser_beam(shot.aim, shot.position, shot.from_player);
+                break;
+            case MISSILE_BULLET:
+                make_missile_bullet(shot.aim, shot.position, shot.from_player);
+                break;
+            }
+        }
+    }
 
-        paa::Position& pos = e.attachPosition(posRef);
-        paa::Sprite& sprite = e.attachSprite("basic_bullet");
-        auto global_bounds = sprite->getGlobalBounds();
+    template <typename B>
+    static void spawn_bullet(const paa::Prefab& prefab, float aim_angle,
+        paa::Position const& posRef, const bool& from_player)
+    {
+        paa::DynamicEntity e = prefab.instantiate(PAA_ECS, posRef);
 
-        sprite->setRotation(aim_angle, true);
+        e.getComponent<paa::Sprite>()->setRotation(aim_angle, true);
         e.emplaceComponent<paa::SCollisionBox>(
             CollisionFactory::makeBulletCollision(
-                paa::IntRect(
-                    pos.x, pos.y, global_bounds.width, global_bounds.height),
-                e.getEntity(), from_player));
+                prefab.getBounds(posRef), e.getEntity(), from_player));
 
-        sprite->useAnimation("base_animation");
-        auto bullet
-            = make_bullet<BasicBullet>(e.getEntity(), aim_angle, from_player);
+        auto bullet = BulletFactory::make_bullet<B>(
+            e.getEntity(), aim_angle, from_player);
         e.insertComponent(std::move(bullet));
     }
 
+    void BulletFactory::make_basic_bullet(
+        float aim_angle, paa::Position const& posRef, const bool& from_player)
+    {
+        spawn_bullet<BasicBullet>(
+            *_prefabs[BASIC_BULLET], aim_angle, posRef, from_player);
+    }
+
     void BulletFactory::make_mattis_bullet(
          float aim_angle, paa::Position const& posRef, const bool& from_player)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-
-        paa::Sprite& sprite = e.attachSprite("mattis_bullet");
-        auto global_bounds = sprite->getGlobalBounds();
-        paa::Position& pos = e.attachPosition(posRef);
-
-        sprite->setRotation(aim_angle, true);
-        e.emplaceComponent<paa::SCollisionBox>(
-            CollisionFactory::makeBulletCollision(
-                paa::IntRect(
-                    pos.x, pos.y, global_bounds.width, global_bounds.height),
-                e.getEntity(), from_player));
-        sprite->useAnimation("mattis_bullet_animation");
-        auto bullet
-            = make_bullet<MattisBullet>(e.getEntity(), aim_angle, from_player);
-        e.insertComponent(std::move(bullet));
+        spawn_bullet<MattisBullet>(
+            *_prefabs[MATTIS_BULLET], aim_angle, posRef, from_player);
     }
 
     void BulletFactory::make_laser_beam(float aim_angle,
             paa::Position const& posRef, const bool& from_player)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-
-        paa::Sprite& sprite = e.attachSprite("laser_beam");
-        auto global_bounds = sprite->getGlobalBounds();
-        paa::Position& pos = e.attachPosition(posRef);
-
-        sprite->setRotation(aim_angle, true);
-        e.emplaceComponent<paa::SCollisionBox>(
-            CollisionFactory::makeBulletCollision(
-                paa::IntRect(
-                    pos.x, pos.y, global_bounds.width, global_bounds.height),
-                e.getEntity(), from_player));
-        sprite->useAnimation("laser_beam_animation");
-        auto bullet
-            = make_bullet<LaserBeam>(e.getEntity(), aim_angle, from_player);
-        e.insertComponent(std::move(bullet));
+        spawn_bullet<LaserBeam>(
+            *_prefabs[LASER_BEAM], aim_angle, posRef, from_player);
     }
 
     void BulletFactory::make_skeleton_bullet(
         float aim_angle, paa::Position const& posRef, const bool& from_player)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-
-        paa::Sprite& sprite = e.attachSprite("skeleton_bullet");
-        auto global_bounds = sprite->getGlobalBounds();
-        paa::Position& pos = e.attachPosition(posRef);
-
-        sprite->setRotation(aim_angle, true);
-        e.emplaceComponent<paa::SCollisionBox>(
-            CollisionFactory::makeBulletCollision(
-                paa::IntRect(
-                    pos.x, pos.y, global_bounds.width, global_bounds.height),
-                e.getEntity(), from_player));
-
-        sprite->useAnimation("skeleton_bullet_animation");
-        auto bullet
-            = make_bullet<SkeletonBullet>(e.getEntity(), aim_angle, from_player);
-        e.insertComponent(std::move(bullet));
+        spawn_bullet<SkeletonBullet>(
+            *_prefabs[SKELETON_BULLET], aim_angle, posRef, from_player);
     }
 
     void BulletFactory::make_missile_bullet(
         float aim_angle, paa::Position const& posRef, const bool& from_player)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-        paa::Sprite& sprite = e.attachSprite("robot_boss");
-        auto global_bounds = sprite->getGlobalBounds();
-        paa::Position& pos = e.attachPosition(posRef);
-
-        sprite->setRotation(aim_angle, true);
-        e.emplaceComponent<paa::SCollisionBox>(
-            CollisionFactory::makeBulletCollision(
-                paa::IntRect(
-                    pos.x, pos.y, global_bounds.width, global_bounds.height),
-                e.getEntity(), from_player));
-
-        sprite->useAnimation("missile");
-        auto bullet
-            = make_bullet<MissileBullet>(e.getEntity(), aim_angle, from_player);
-        e.insertComponent(std::move(bullet));
+        spawn_bullet<MissileBullet>(
+            *_prefabs[MISSILE_BULLET], aim_angle, posRef, from_player);
     }
 };
 }
@@ -48,7 +48,7 @@ namespace game {
         return _parentEntity.hasComponent<rtype::game::Player>();
     }
 
-    void AShooter::shoot_from_pos(std::string const& bullet_type,
+    void AShooter::shoot_from_pos(BulletType bullet_type,
             paa::Position const& pos)
     {
         if (can_shoot_and_restart()) {
@@ -57,7 +57,17 @@ namespace game {
         }
     }
 
-    void BasicShooter::shoot(std::string const& bullet_type)
+    ShooterList clone_shooters(const ShooterList& shooters)
+    {
+        ShooterList copies;
+
+        copies.reserve(shooters.size());
+        for (const auto& shooter : shooters)
+            copies.push_back(shooter->clone());
+        return copies;
+    }
+
+    void BasicShooter::shoot(BulletType bullet_type)
     {
         if (can_shoot_and_restart()) {
             paa::Position pos = _parentEntity.getComponent<paa::Position>();
@@ -67,10 +77,15 @@ namespace game {
             pos.y += (sprite->getGlobalBounds().height / 2);
             BulletFactory::make_bullet_by_type(bullet_type, pos,
                         is_attached_to_player(), _aim_angle);
-            _sound.play();
+            _sound->play();
         }
     }
 
+    Shooter BasicShooter::clone() const
+    {
+        return make_shooter<BasicShooter>(*this);
+    }
+
     ConeShooter::ConeShooter(const PAA_ENTITY& e, double reloadTime) :
                                             AShooter(e, reloadTime)
     {
@@ -84,7 +99,7 @@ namespace game {
         }
     }
 
-    void ConeShooter::shoot(std::string const& bullet_type)
+    void ConeShooter::shoot(BulletType bullet_type)
     {
         if (can_shoot_and_restart()) {
             paa::Position pos = _parentEntity.getComponent<paa::Position>();
@@ -96,5 +111,13 @@ namespace game {
                 shooter->shoot(bullet_type);
         }
     }
+
+    Shooter ConeShooter::clone() const
+    {
+        auto copy = paa::make_pooled<ConeShooter>(*this);
+
+        copy->_shooterList = clone_shooters(_shooterList);
+        return copy;
+    }
 }
 }
@@ -32,16 +32,12 @@ namespace game {
 
     PAA_ENTITY EnemyFactory::make_key_enemy(double const& x, double const& y)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
+        const paa::Prefab& prefab = get_prefab(KEY_ENEMY_PREFAB);
+        const paa::Position pos(x, y);
+        paa::DynamicEntity e = prefab.instantiate(PAA_ECS, pos);
 
-        auto& s = e.attachSprite("key_enemy")
-                      ->setPosition(x, y)
-                      .useAnimation("key_animation");
-
-        e.attachHealth(paa::Health(3));
-        e.attachPosition(paa::Position(x, y));
         e.attachCollision(CollisionFactory::makeEnemyCollision(
-            paa::recTo<int>(s.getGlobalBounds()), e.getEntity()));
+            prefab.getBounds(pos), e.getEntity()));
         Enemy ke = EnemyFactory::make_enemy<KeyEnemy>(e.getEntity());
         e.insertComponent(std::move(ke));
         return e.getEntity();
@@ -50,16 +46,12 @@ namespace game {
     PAA_ENTITY EnemyFactory::make_mastodonte_enemy(
         double const& x, double const& y)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-
-        auto& s = e.attachSprite("mastodonte_enemy")
-                      ->setPosition(x, y)
-                      .useAnimation("mastodonte_animation")
-                      .setScale(-1, 1);
-        e.attachHealth(paa::Health(6));
-        e.attachPosition(paa::Position(x, y));
+        const paa::Prefab& prefab = get_prefab(MASTODONTE_ENEMY_PREFAB);
+        const paa::Position pos(x, y);
+        paa::DynamicEntity e = prefab.instantiate(PAA_ECS, pos);
+
         e.attachCollision(CollisionFactory::makeEnemyCollision(
-            paa::recTo<int>(s.getGlobalBounds()), e.getEntity()));
+            prefab.getBounds(pos), e.getEntity()));
         Enemy masto = EnemyFactory::make_enemy<MastodonteEnemy>(e.getEntity());
         e.insertComponent(std::move(masto));
         return e.getEntity();
@@ -68,15 +60,12 @@ namespace game {
     PAA_ENTITY EnemyFactory::make_dumby_boy_enemy(
         double const& x, double const& y)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
+        const paa::Prefab& prefab = get_prefab(DUMBY_BOY_ENEMY_PREFAB);
+        const paa::Position pos(x, y);
+        paa::DynamicEntity e = prefab.instantiate(PAA_ECS, pos);
 
-        auto& s = e.attachSprite("dumby_boy_enemy")
-                      ->setPosition(x, y)
-                      .useAnimation("dumby_boy_enemy_animation");
-        e.attachHealth(paa::Health(4));
-        e.attachPosition(paa::Position(x, y));
         e.attachCollision(CollisionFactory::makeEnemyCollision(
-            paa::recTo<int>(s.getGlobalBounds()), e.getEntity()));
+            prefab.getBounds(pos), e.getEntity()));
         Enemy dmb = EnemyFactory::make_enemy<DumbyBoy>(e.getEntity());
         e.insertComponent(std::move(dmb));
         return e.getEntity();
@@ -85,23 +74,15 @@ namespace game {
     PAA_ENTITY EnemyFactory::make_skeleton_boss(double const &x,
                                                 double const &y)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-        paa::DynamicEntity head = PAA_NEW_ENTITY();
+        const paa::Prefab& head_prefab = get_prefab(SKELETON_BOSS_HEAD_PREFAB);
+        paa::DynamicEntity e = get_prefab(SKELETON_BOSS_PREFAB)
+            .instantiate(PAA_ECS, paa::Position(x, y));
         paa::Position head_position = paa::Position(
             x + (159.0f/*Boss sprite width*/ / 2), y + (190.0f/*Boss sprite height*/ / 2));
-        auto& s = e.attachSprite("skeleton_boss")
-                      ->setPosition(x, y)
-                      .useAnimation("skeleton_boss_animation");
-        auto& head_s = head.attachSprite("skeleton_boss_head");
-        auto& head_s_animated = head_s->setPosition(
-                        head_position.x, head_position.y)
-                        .useAnimation("skeleton_boss_head_animation");
-        e.attachHealth(paa::Health(10000));
-        e.attachPosition(paa::Position(x, y));
-        head.attachHealth(paa::Health(100));
-        head.attachPosition(head_position);
+        paa::DynamicEntity head = head_prefab.instantiate(PAA_ECS, head_position);
+        auto& head_s = head.getComponent<paa::Sprite>();
         head.attachCollision(CollisionFactory::makeEnemyCollision(
-            paa::recTo<int>(head_s_animated.getGlobalBounds()), head.getEntity()));
+            head_prefab.getBounds(head_position), head.getEntity()));
         Enemy skeleton = EnemyFactory::make_enemy<SkeletonBoss>(e.getEntity());
         Enemy skeletonHead = EnemyFactory::make_enemy<SkeletonBossHead>(
             head.getEntity(), e.getEntity(), head_s);
@@ -112,15 +93,12 @@ namespace game {
 
     PAA_ENTITY EnemyFactory::make_mattis_boss(double const& x, double const& y)
     {
-        paa::DynamicEntity body = PAA_NEW_ENTITY();
+        const paa::Prefab& prefab = get_prefab(MATTIS_BOSS_FACE_PREFAB);
+        const paa::Position pos(x, y);
+        paa::DynamicEntity body = prefab.instantiate(PAA_ECS, pos);
 
-        auto& body_s = body.attachSprite("mattis_boss_face")
-            ->setPosition(x, y)
-            .useAnimation("mattis_boss_head_basic");
-        body.attachHealth(paa::Health(200));
-        body.attachPosition(paa::Position(x, y));
         body.attachCollision(CollisionFactory::makeEnemyCollision(
-            paa::recTo<int>(body_s.getGlobalBounds()), body.getEntity()));
+            prefab.getBounds(pos), body.getEntity()));
         Enemy body_top = EnemyFactory::make_enemy<Mattis>(body.getEntity());
         body.insertComponent(std::move(body_top));
         return body.getEntity();
@@ -146,17 +124,13 @@ namespace game {
         return body.getEntity();
         */
 
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-
-        e.attachPosition(paa::Position(x, y));
-        e.attachHealth(paa::Health(3));
-
-        auto& s = e.attachSprite("robot_boss");
-        s->useAnimation("eye_open_animation", false).setPosition(x, y);
+        const paa::Prefab& prefab = get_prefab(ROBOT_BOSS_EYE_PREFAB);
+        const paa::Position pos(x, y);
+        paa::DynamicEntity e = prefab.instantiate(PAA_ECS, pos);
 
         e.attachCollision(
             CollisionFactory::makeEnemyCollision(
-                paa::recTo<int>(s->getGlobalBounds()),
+                prefab.getBounds(pos),
                 e.getEntity()
             )
         );
@@ -31,22 +31,19 @@ namespace game {
         posRef.x -= 60 * deltaTime;
         posRef.y += value;
         if (_last_shoot >= _shoot_cycle) {
-            _shooterList[0]->shoot("basic_bullet");
+            _shooterList[0]->shoot(BASIC_BULLET);
             _last_shoot = 0.0f;
         }
     }
 
     PAA_ENTITY EnemyFactory::make_basic_enemy(double const& x, double const& y)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-        auto& s = e.attachSprite("basic_enemy")
-                      ->setPosition(x, y)
-                      .useAnimation("base_animation");
+        const paa::Prefab& prefab = get_prefab(BASIC_ENEMY_PREFAB);
+        const paa::Position pos(x, y);
+        paa::DynamicEntity e = prefab.instantiate(PAA_ECS, pos);
 
-        e.attachHealth(paa::Health(5));
-        e.attachPosition(paa::Position(x, y));
         e.attachCollision(CollisionFactory::makeEnemyCollision(
-            paa::recTo<int>(s.getGlobalBounds()), e.getEntity()));
+            prefab.getBounds(pos), e.getEntity()));
 
         Enemy be = EnemyFactory::make_enemy<BasicEnemy>(e.getEntity());
         e.insertComponent(std::move(be));
@@ -46,18 +46,15 @@ namespace game {
     PAA_ENTITY CentipedeBody::build_centipede(const PAA_ENTITY& parent, int depth)
     {
         paa::DynamicEntity dp = parent;
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-        auto s = e.attachSprite("centiped_boss");
-
-        depth ? s->useAnimation("body") : s->useAnimation("head");
+        const paa::Prefab& prefab = EnemyFactory::get_prefab(depth
+                ? EnemyFactory::CENTIPEDE_BODY_PREFAB
+                : EnemyFactory::CENTIPEDE_HEAD_PREFAB);
         auto ppos = dp.getComponent<paa::Position>();
+        paa::DynamicEntity e = prefab.instantiate(PAA_ECS, ppos);
 
-        e.attachPosition(ppos);
         e.attachHealth(paa::Health(RTYPE_CENTIPEDE_HP));
-        s->setPosition(ppos.x, ppos.y);
-        s->setOrigin(s->getGlobalBounds().width / 2, s->getGlobalBounds().height / 2);
         e.attachCollision(CollisionFactory::makeEnemyCollision(
-            paa::recTo<int>(s->getGlobalBounds()), e.getEntity()));
+            prefab.getBounds(ppos), e.getEntity()));
 
         e.attachId(paa::Id(-1));
 
@@ -373,17 +370,13 @@ namespace game {
 
     PAA_ENTITY EnemyFactory::make_centipede_boss(double const& x, double const& y)
     {
-        paa::DynamicEntity e = PAA_NEW_ENTITY();
-        auto s = e.attachSprite("centiped_boss");
-
-        s->useAnimation("head");
+        const paa::Prefab& prefab = get_prefab(CENTIPEDE_HEAD_PREFAB);
+        const paa::Position pos(x, y);
+        paa::DynamicEntity e = prefab.instantiate(PAA_ECS, pos);
 
-        e.attachPosition(paa::Position(x, y));
         e.attachHealth(paa::Health(1));
-        s->setPosition(x, y);
-        s->setOrigin(s->getGlobalBounds().width / 2, s->getGlobalBounds().height / 2);
         e.attachCollision(CollisionFactory::makeEnemyCollision(
-            paa::recTo<int>(s->getGlobalBounds()), e.getEntity()));
+            prefab.getBounds(pos), e.getEntity()));
 
         Enemy enemy = EnemyFactory::make_enemy<Centipede>(e.getEntity());
         e.insertComponent(std::move(enemy));
@@ -1,12 +1,11 @@
 #include "Bullet.hpp"
 #include "Enemies.hpp"
-#include <functional>
 #include <unordered_map>
 
 namespace rtype {
 namespace game {
 
-    static std::unordered_map<std::string, std::function<PAA_ENTITY(const float, const float)>> ENEMY_CREATOR = {
+    static std::unordered_map<std::string, EnemyFactory::creator_t> ENEMY_CREATOR = {
         { "basic_enemy", EnemyFactory::make_basic_enemy },
         { "key_enemy", EnemyFactory::make_key_enemy },
         { "mastodonte_enemy", EnemyFactory::make_mastodonte_enemy },
@@ -17,16 +16,83 @@ namespace game {
         { "mattis_boss", EnemyFactory::make_mattis_boss }
     };
 
-    PAA_ENTITY EnemyFactory::make_enemy_by_type(
-        const std::string& enemy_type, const float x, const float y)
+    static void center_origin(paa::AnimatedSprite& s)
     {
-        spdlog::info("Creating enemy of type {} at ({}, {})", enemy_type, x, y);
+        s.setOrigin(s.getGlobalBounds().width / 2, s.getGlobalBounds().height / 2);
+    }
+
+    void EnemyFactory::register_prefabs()
+    {
+        auto& prefabs = PAA_PREFAB_REGISTER;
+
+        _prefabs[BASIC_ENEMY_PREFAB] = &prefabs.addPrefab("basic_enemy",
+            paa::Prefab("basic_enemy", paa::Prefab::animation("base_animation"))
+                .with(paa::Health(5)));
+        _prefabs[KEY_ENEMY_PREFAB] = &prefabs.addPrefab("key_enemy",
+            paa::Prefab("key_enemy", paa::Prefab::animation("key_animation"))
+                .with(paa::Health(3)));
+        _prefabs[MASTODONTE_ENEMY_PREFAB] = &prefabs.addPrefab("mastodonte_enemy",
+            paa::Prefab("mastodonte_enemy", [](paa::AnimatedSprite& s) {
+                s.useAnimation("mastodonte_animation").setScale(-1, 1);
+            }).with(paa::Health(6)));
+        _prefabs[DUMBY_BOY_ENEMY_PREFAB] = &prefabs.addPrefab("dumby_boy_enemy",
+            paa::Prefab("dumby_boy_enemy",
+                paa::Prefab::animation("dumby_boy_enemy_animation"))
+                .with(paa::Health(4)));
+        _prefabs[SKELETON_BOSS_PREFAB] = &prefabs.addPrefab("skeleton_boss",
+            paa::Prefab("skeleton_boss",
+                paa::Prefab::animation("skeleton_boss_animation"))
+                .with(paa::Health(10000)));
+        _prefabs[SKELETON_BOSS_HEAD_PREFAB] = &prefabs.addPrefab("skeleton_boss_head",
+            paa::Prefab("skeleton_boss_head",
+                paa::Prefab::animation("skeleton_boss_head_animation"))
+                .with(paa::Health(100)));
+        _prefabs[MATTIS_BOSS_FACE_PREFAB] = &prefabs.addPrefab("mattis_boss_face",
+            paa::Prefab("mattis_boss_face",
+                paa::Prefab::animation("mattis_boss_head_basic"))
+                .with(paa::Health(200)));
+        _prefabs[MATTIS_BOSS_MOUTH_PREFAB] = &prefabs.addPrefab("mattis_boss_mouth",
+            paa::Prefab("mattis_boss_mouth",
+                paa::Prefab::animation("mattis_boss_mouth_basic"))
+                .with(paa::Id(-1)));
+        _prefabs[CENTIPEDE_HEAD_PREFAB] = &prefabs.addPrefab("centipede_head",
+            paa::Prefab("centiped_boss", [](paa::AnimatedSprite& s) {
+                center_origin(s.useAnimation("head"));
+            }));
+        _prefabs[CENTIPEDE_BODY_PREFAB] = &prefabs.addPrefab("centipede_body",
+            paa::Prefab("centiped_boss", [](paa::AnimatedSprite& s) {
+                center_origin(s.useAnimation("body"));
+            }));
+        _prefabs[ROBOT_BOSS_EYE_PREFAB] = &prefabs.addPrefab("robot_boss_eye",
+            paa::Prefab("robot_boss",
+                paa::Prefab::animation("eye_open_animation", false))
+                .with(paa::Health(3)));
+        _prefabs[ROBOT_BOSS_BODY_PREFAB] = &prefabs.addPrefab("robot_boss_body",
+            paa::Prefab("robot_boss", paa::Prefab::animation("boss")));
+        _prefabs[ROBOT_BOSS_UP_BOOSTER_PREFAB] = &prefabs.addPrefab("robot_boss_up_booster",
+            paa::Prefab("robot_boss", paa::Prefab::animation("up_booster")));
+        _prefabs[ROBOT_BOSS_DOWN_BOOSTER_PREFAB] = &prefabs.addPrefab("robot_boss_down_booster",
+            paa::Prefab("robot_boss", paa::Prefab::animation("down_booster")));
+        _prefabs[ROBOT_BOSS_WEAPON_PREFAB] = &prefabs.addPrefab("robot_boss_weapon",
+            paa::Prefab("robot_boss", paa::Prefab::animation("weapon")));
+    }
 
+    EnemyFactory::creator_t EnemyFactory::get_creator(
+        const std::string& enemy_type)
+    {
         auto it = ENEMY_CREATOR.find(enemy_type);
         if (it == ENEMY_CREATOR.end()) {
             throw std::runtime_error("Unknown enemy type: " + enemy_type);
         }
-        return it->second(x, y);
+        return it->second;
+    }
+
+    PAA_ENTITY EnemyFactory::make_enemy_by_type(
+        const std::string& enemy_type, const float x, const float y)
+    {
+        spdlog::info("Creating enemy of type {} at ({}, {})", enemy_type, x, y);
+
+        return get_creator(enemy_type)(x, y);
     }
 
 }
@@ -8,16 +8,12 @@ namespace game {
 
     Mattis::Mattis(const PAA_ENTITY& e) : AEnemy(e, MATTIS_BOSS)
     {
-        paa::DynamicEntity mouth = PAA_NEW_ENTITY();
         auto& position = PAA_GET_COMPONENT(e, paa::Position);
         auto& health = PAA_GET_COMPONENT(e, paa::Health);
-        auto& s = mouth.attachSprite("mattis_boss_mouth")
-                          ->setPosition(position.x, position.y)
-                          .useAnimation("mattis_boss_mouth_basic");
+        paa::DynamicEntity mouth = EnemyFactory::get_prefab(
+            EnemyFactory::MATTIS_BOSS_MOUTH_PREFAB).instantiate(PAA_ECS, position);
 
-        mouth.attachId(paa::Id(-1));
         mouth.attachHealth(health);
-        mouth.attachPosition(position);
         Enemy entity = EnemyFactory::make_enemy<MattisMouth>(mouth.getEntity(), _e);
         mouth.insertComponent(std::move(entity));
         _mouth = mouth;
@@ -47,8 +43,8 @@ namespace game {
             for (std::size_t i = 0; i < _shooterList.size(); i++) {
                 auto fixed_pos = paa::Position(pos.x + _eye_offset[i][0],
                         pos.y + _eye_offset[i][1]);
-                _shooterList[i]->shoot_from_pos("laser_beam", fixed_pos);
-                _laser.play();
+                _shooterList[i]->shoot_from_pos(LASER_BEAM, fixed_pos);
+                _laser->play();
             }
             _current_shoot_duration += deltaTime;
             if (_current_shoot_duration >= _shoot_duration) {
@@ -147,8 +143,8 @@ namespace game {
             const paa::Position right_position(pos.x + 28, pos.y + 100);
             if (_last_shoot >= _shooting_speed) {
                 _shooterList[_shoot_index++]
-                    ->shoot_from_pos("mattis_bullet", right_position);
-                _ghast.play();
+                    ->shoot_from_pos(MATTIS_BULLET, right_position);
+                _ghast->play();
                 _last_shoot = 0.0f;
             }
             if (_shoot_index >= _shooterList.size()) {
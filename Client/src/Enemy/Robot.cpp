@@ -36,24 +36,27 @@ namespace game {
             : _self(paa::make_dynamic_entity(self))
             , _eye(paa::make_dynamic_entity(eye))
         {
-            static const char *const animations[] = {
-                "up_booster", "down_booster", "weapon", "weapon"
+            static const EnemyFactory::PrefabId parts[] = {
+                EnemyFactory::ROBOT_BOSS_UP_BOOSTER_PREFAB,
+                EnemyFactory::ROBOT_BOSS_DOWN_BOOSTER_PREFAB,
+                EnemyFactory::ROBOT_BOSS_WEAPON_PREFAB,
+                EnemyFactory::ROBOT_BOSS_WEAPON_PREFAB
             };
             std::reference_wrapper<paa::SDynamicEntity> entities_ref[] = {
                 _up_booster, _down_booster, _up_shooter, _down_shooter
             };
+            // A copy, spawning the parts may move the positions in memory
+            const paa::Position pos = _eye->getComponent<paa::Position>();
 
-            _self->attachSprite("robot_boss")->useAnimation("boss");
-            _self->attachPosition(_eye->getComponent<paa::Position>());
+            _self->attachSprite(EnemyFactory::get_prefab(EnemyFactory::ROBOT_BOSS_BODY_PREFAB));
+            _self->attachPosition(pos);
 
             for (size_t i = 0; i < 4; ++i) {
-                entities_ref[i].get() = paa::make_dynamic_entity(PAA_NEW_ENTITY());
-                entities_ref[i].get()->attachSprite("robot_boss")->useAnimation(animations[i]);
-                entities_ref[i].get()->attachPosition(_eye->getComponent<paa::Position>());
+                const paa::Prefab& prefab = EnemyFactory::get_prefab(parts[i]);
 
+                entities_ref[i].get() = paa::make_dynamic_entity(prefab.instantiate(PAA_ECS, pos));
                 entities_ref[i].get()->attachCollision(CollisionFactory::makeTransparentWallCollision(
-                    paa::recTo<int>(entities_ref[i].get()->getComponent<paa::Sprite>()->getGlobalBounds()),
-                    entities_ref[i].get()->getEntity()));
+                    prefab.getBounds(pos), entities_ref[i].get()->getEntity()));
             }
 
             new_position_direction_shooter(dir_y_top, UP_SHOOTER_MIN_Y);
@@ -129,8 +132,8 @@ namespace game {
                     _down_shooter_comp->aim(paa::Vector2f(player.x, player.y));
                 } catch (...) {}
             }*/
-            _up_shooter_comp->shoot("missile_bullet");
-            _down_shooter_comp->shoot("missile_bullet");
+            _up_shooter_comp->shoot(MISSILE_BULLET);
+            _down_shooter_comp->shoot(MISSILE_BULLET);
         }
     };
 
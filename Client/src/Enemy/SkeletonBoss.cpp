@@ -40,7 +40,7 @@ namespace game {
         auto size = _shooterList.size();
         if (_last_shoot >= _shoot_cycle) {
             if (_shoot_delay >= .5f && _shoot_index < size) {
-                _shooterList[_shoot_index++]->shoot("skeleton_bullet");
+                _shooterList[_shoot_index++]->shoot(SKELETON_BULLET);
                 _head_sprite->useAnimation("skeleton_boss_head_shoot_animation");
             }
             if (_shoot_index >= size) {
@@ -19,8 +19,8 @@ namespace game {
     void Wave::addWaveData(
         const std::string& enemy_type, uint64_t enemy_id, float x, float y)
     {
-        _waves.push_back(
-            std::make_unique<WaveData>(enemy_type, enemy_id, x, y));
+        _waves.push_back(std::make_unique<WaveData>(enemy_type,
+            EnemyFactory::get_creator(enemy_type), enemy_id, x, y));
     }
 
     void Wave::activateWave()
@@ -33,9 +33,7 @@ namespace game {
         }
 
         for (const auto& wave : _waves) {
-            paa::DynamicEntity e
-                = rtype::game::EnemyFactory::make_enemy_by_type(
-                    wave->enemy_type, wave->x, wave->y);
+            paa::DynamicEntity e = wave->creator(wave->x, wave->y);
             g_game.enemies_to_entities[e.attachId(wave->enemy_id).id]
                 = e.getEntity();
             if (connected_players == -1)
@@ -131,6 +129,7 @@ namespace game {
             }
         }
 
+        _progress.applied.assign(_zones.getEffects().size(), false);
         std::filesystem::current_path(old_path);
     }
 
@@ -199,18 +198,20 @@ namespace game {
         }
 
         auto& effects = _zones.getEffects();
-        std::vector<int> to_delete;
+        bool activated = false;
 
-        for (int i = 0; i < effects.size(); i++) {
+        // The effects are kept, a lockstep rollback may apply them again
+        // (see Map::restore)
+        for (std::size_t i = 0; i < effects.size(); i++) {
             auto& effect = effects[i];
-            if (effect->scroll_index <= g_game.scroll) {
+            if (!_progress.applied[i] && effect->scroll_index <= g_game.scroll) {
                 if (effect->type == "activate_wave") {
                     activate_wave_event(_waves, effect->name);
                 } else if (effect->type == "lock_scroll") {
                     lock_scroll_event();
                 } else if (effect->type.starts_with("end")) {
                     g_game.launch_transition(effect->type.find("short") == std::string::npos);
-                    _changes = true;
+                    _progress.changes = true;
                 } else if (effect->type == "launch_music") {
                     activate_play_music_event(*effect);
                 } else if (effect->type == "show_gui") {
@@ -224,34 +225,36 @@ namespace game {
                 } else if (effect->type.starts_with("scroll_speed=")) {
                     g_game.scroll_speed = std::atoi(effect->type.c_str() + 13);
                 }
-                to_delete.push_back(i - to_delete.size());
+                _progress.applied[i] = true;
+                activated = true;
                 spdlog::info("effect {} of type {} activated", effect->name,
                     effect->type);
             }
         }
 
         // Sync everyone when effects zones are activated
-        if (to_delete.size() && g_game.is_host) {
-            g_game.service.tcp().send(
+        // (the scroll is simulated by everyone in lockstep mode)
+        if (activated && g_game.is_host && !g_game.lockstep_delay) {
+            g_game.service.udp().send(
                 net::UpdateMessage(g_game.id, SerializedScroll(static_cast<int>(g_game.scroll)),
                 net::message_code::UPDATE_SCROLL)
             );
         }
-        for (int i = 0; i < to_delete.size(); i++) {
-            effects.erase(effects.begin() + to_delete[i]);
-        }
     }
 
     bool Map::changes()
     {
-        return _changes;
+        return _progress.changes;
     }
 
     void WaveManager::activateWave(const std::string& name)
     {
+        auto wave = _wave.find(name);
+
         spdlog::info("Activating wave {}", name);
-        _wave[name]->activateWave();
-        _wave.erase(name);
+        // The wave is kept so that a lockstep rollback spawns it again
+        if (wave != _wave.end())
+            wave->second->activateWave();
     }
 
     void WaveManager::addWave(
@@ -1,3 +1,4 @@
+#include "Bullet.hpp"
 #include "ClientScenes.hpp"
 #include "Player.hpp"
 #include "utils.hpp"
@@ -16,7 +17,6 @@ namespace game {
     {
         _wallDeathTimer.setTarget(WALL_DEATH_TIME);
         _syncTimer.setTarget(SYNC_RATE);
-        _syncWithTcpTimer.setTarget(SYNC_WITH_TCP_RATE);
         _frameTimer.setTarget(FRAME_RATE);
         _hurtTimer.setTarget(HURT_TIME);
         _speed_x = SPEED_X;
@@ -38,39 +38,63 @@ namespace game {
 
     void APlayer::update_info(const SerializablePlayer& info)
     {
-        auto& positionRef = _entity.getComponent<paa::Position>();
         auto& healthRef = _entity.getComponent<paa::Health>();
 
         _info = info;
 
         healthRef.hp = info.get_hp();
 
-        const auto minoffsetx = SPEED_X / 10;
-        const auto minoffsety = SPEED_Y / 10;
-        const auto offsetx = info.get_pos().x - positionRef.x;
-        const auto offsety = info.get_pos().y - positionRef.y;
-
-        _controllerRef->simulateAxisMovement(paa::Joystick::Axis::X,
-            offsetx < -minoffsetx     ? 100
-                : offsetx > minoffsetx ? -100
-                                      : 0);
-
-        _controllerRef->simulateAxisMovement(paa::Joystick::Axis::Y,
-            offsety < -minoffsety      ? 100
-                : offsety > minoffsety ? -100
-                                      : 0);
+        // The position is relative to the scroll, it is rendered from the
+        // interpolation buffer (see update_interpolated_position)
+        _interpolation.push(paa::Vec2(info.pos.x, info.pos.y),
+            info.get_move_left() || info.get_move_right()
+                || info.get_move_up() || info.get_move_down());
 
         info.get_shoot()
             ? _controllerRef->simulateButtonHeld(RTYPE_SHOOT_BUTTON)
             : _controllerRef->simulateButtonIdle(RTYPE_SHOOT_BUTTON);
     }
 
+    void APlayer::reconcile(const SerializablePlayer& info)
+    {
+        if (!_is_local)
+            return;
+
+        auto& positionRef = _entity.getComponent<paa::Position>();
+        const auto bounds = _spriteRef->getGlobalBounds();
+        const paa::Vec2 max(RTYPE_PLAYFIELD_WIDTH - bounds.width,
+            RTYPE_PLAYFIELD_HEIGHT - bounds.height);
+        paa::Vec2 position;
+
+        if (_prediction.reconcile(info.tick,
+                paa::Vec2(info.pos.x, info.pos.y),
+                paa::Vec2(_speed_x, _speed_y), max, position)) {
+            positionRef.x = position.x + g_game.scroll;
+            positionRef.y = position.y;
+            _lastCorrectPos = position;
+        }
+    }
+
+    void APlayer::replay_inputs(const std::vector<net::input_frame>& frames)
+    {
+        if (_is_local || frames.empty())
+            return;
+
+        // The newest frame is the current state (see update_info), the
+        // others were carried by lost packets
+        for (std::size_t i = 0; i + 1 < frames.size(); ++i)
+            if (frames[i].bits & SerializablePlayer::SHOOT_MASK)
+                _missed_shot = true;
+    }
+
     void APlayer::update_shoot()
     {
-        if (_controllerRef->isButtonPressedOrHeld(RTYPE_SHOOT_BUTTON)) {
+        if (_controllerRef->isButtonPressedOrHeld(RTYPE_SHOOT_BUTTON)
+            || _missed_shot) {
             for (auto& shooter : _shooterList)
-                shooter->shoot("basic_bullet");
+                shooter->shoot(BASIC_BULLET);
         }
+        _missed_shot = false;
     }
 
     void APlayer::update_data()
@@ -81,19 +105,36 @@ namespace game {
         // and if the timer is ready
         //
         
-        if (_is_local && g_game.service.tcp_is_connected()) {
+        // In lockstep mode only the inputs are exchanged (see SceneGame)
+        if (_is_local && !g_game.lockstep_delay
+            && g_game.service.tcp_is_connected()) {
+            auto& udp = g_game.service.udp();
             SerializablePlayer info(_entity.getEntity());
-            if (_syncTimer.isFinished() || !info.data_is_same(_info) || _syncWithTcpTimer.isFinished()) {
-                if (_syncWithTcpTimer.isFinished()) {
-                    g_game.service.tcp().send(net::UpdateMessage(
-                        _id.id, info, net::message_code::UPDATE_PLAYER));
-                    _syncWithTcpTimer.restart();
-                } else {
-                    g_game.service.udp().send(net::UpdateMessage(
-                        _id.id, info, net::message_code::UPDATE_PLAYER));
+            info.tick = _prediction.tick();
+            const bool changed = !info.data_is_same(_info);
+            // The last input changes are sent with every snapshot so the
+            // ones of a lost packet are not lost
+            _inputs.push(udp.clock().tick(),
+                info.data & SerializablePlayer::INPUT_MASK);
+            // The snapshots are spaced by the interval of the connection, it
+            // grows when the connection is congested and the changes made
+            // in between are sent together
+            _rateTimer.setTarget(udp.feed_reliability().send_interval().count());
+            if ((_syncTimer.isFinished() || changed) && _rateTimer.isFinished()) {
+                // Only the fields that changed since the last snapshot acked
+                // by the server are sent, and nothing once it is up to date
+                if (changed
+                    || !_snapshots.up_to_date(info, udp.feed_reliability())) {
+                    const net::feed_header header = udp.send(net::UpdateMessage(_id.id,
+                        net::player_update(
+                            _snapshots.encode(info, udp.feed_reliability()),
+                            _inputs.frames()),
+                        net::message_code::UPDATE_PLAYER));
+                    _snapshots.sent(header.sequence);
                 }
                 _info = info;
                 _syncTimer.restart();
+                _rateTimer.restart();
             }
         }
     }
@@ -116,8 +157,36 @@ namespace game {
         _spriteRef->useAnimation(anim);
     }
 
+    void APlayer::update_frame(float axis_y)
+    {
+        if (_frameTimer.isFinished()) {
+            _frameTimer.restart();
+            axis_y > 0 ? ++_y_frame : --_y_frame;
+        }
+        _y_frame = std::clamp(_y_frame, 0, Y_FRAMES - 1);
+        use_frame();
+    }
+
+    void APlayer::update_interpolated_position()
+    {
+        auto& positionRef = _entity.getComponent<paa::Position>();
+        const paa::Vec2 position = _interpolation.sample();
+        const double dy = position.y - positionRef.y;
+
+        positionRef.x = position.x + g_game.scroll;
+        positionRef.y = position.y;
+
+        // Going up is a positive axis (see update_position)
+        update_frame(dy < 0 ? 100 : dy > 0 ? -100 : 0);
+    }
+
     void APlayer::update_position()
     {
+        if (!_is_local && !_interpolation.empty()) {
+            update_interpolated_position();
+            return;
+        }
+
         const double xspeed = _speed_x * PAA_DELTA_TIMER.getDeltaTime();
         const double yspeed = _speed_y * PAA_DELTA_TIMER.getDeltaTime();
 
@@ -151,12 +220,14 @@ namespace game {
             positionRef.y = RTYPE_CLAMP(double, positionRef.y, 0, RTYPE_PLAYFIELD_HEIGHT - _spriteRef->getGlobalBounds().height);
         }
 
-        if (_frameTimer.isFinished()) {
-            _frameTimer.restart();
-            axis.y() > 0 ? ++_y_frame : --_y_frame;
+        if (_is_local) {
+            _prediction.record(_moveVector.x() > 0 ? -1 : _moveVector.x() < 0 ? 1 : 0,
+                _moveVector.y() > 0 ? -1 : _moveVector.y() < 0 ? 1 : 0,
+                PAA_DELTA_TIMER.getDeltaTime(),
+                paa::Vec2(positionRef.x - g_game.scroll, positionRef.y));
         }
-        _y_frame = std::clamp(_y_frame, 0, Y_FRAMES - 1);
-        use_frame();
+
+        update_frame(axis.y());
     }
 
     void APlayer::update()
@@ -186,7 +257,7 @@ namespace game {
         }
 
         if (other_id == CollisionType::STATIC_WALL) {
-            _is_colliding_with_wall = _is_local;
+            _is_colliding_with_wall = is_simulated();
         }
 
         bool hurtable_object = other_id == CollisionType::ENEMY_BULLET
@@ -198,7 +269,7 @@ namespace game {
         }
 
         if (hurtable_object && !_is_hurt) {
-            if (_is_local) {
+            if (is_simulated()) {
                 paa::Health& healthRef = PAA_GET_COMPONENT(_entity, paa::Health);
                 if (other_id == CollisionType::STATIC_WALL) {
                     if (!_wallDeath) {
@@ -215,7 +286,7 @@ namespace game {
             }
             _hurtTimer.restart();
             _is_hurt = true;
-            _hurt_sound.play();
+            _hurt_sound->play();
         }
     }
 
@@ -231,6 +302,20 @@ namespace game {
 
     bool APlayer::is_local() const { return _is_local; }
 
+    bool APlayer::is_simulated() const
+    {
+        // Every peer simulates every player in lockstep mode
+        return _is_local || g_game.lockstep_delay;
+    }
+
+    std::shared_ptr<APlayer> APlayer::clone() const
+    {
+        auto copy = paa::make_pooled<APlayer>(*this);
+
+        copy->_shooterList = clone_shooters(_shooterList);
+        return copy;
+    }
+
     PAA_ENTITY PlayerFactory::addPlayer(
         const net::PlayerID pid, paa::Controller& controller, bool checkScreenBounds, bool isOnline)
     {
@@ -245,7 +330,7 @@ namespace game {
 
         entity.emplaceComponent<paa::Controller>(controller);
 
-        auto player = Player(new APlayer(entity.getEntity(), id, sprite, controller, isOnline && pid == g_game.id));
+        auto player = paa::make_pooled<APlayer>(entity.getEntity(), id, sprite, controller, isOnline && pid == g_game.id);
 
         player->set_clamp_position(checkScreenBounds);
 
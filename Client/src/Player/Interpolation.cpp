@@ -0,0 +1,87 @@
+#include "Interpolation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rtype {
+namespace game {
+
+    // Weight of a new measure in the averages of the interval and jitter
+    static constexpr double SMOOTHING = 0.1;
+
+    InterpolationBuffer::InterpolationBuffer(double delay)
+        : _delay(delay)
+    {
+    }
+
+    double InterpolationBuffer::seconds(clock::time_point time)
+    {
+        return std::chrono::duration<double>(time.time_since_epoch()).count();
+    }
+
+    void InterpolationBuffer::push(
+        const paa::Vec2& position, bool moving, clock::time_point now)
+    {
+        const double time = seconds(now);
+
+        if (!_states.empty()) {
+            const double gap = time - _states.back().time;
+
+            if (gap < MAX_INTERVAL) {
+                _jitter += (std::abs(gap - _interval) - _jitter) * SMOOTHING;
+                _interval += (gap - _interval) * SMOOTHING;
+            } else {
+                // The sender paused, stay on the last state until the render
+                // time reaches the new one instead of sliding during the pause
+                _states.push_back({ time - _interval, _states.back().position, false });
+            }
+        }
+        _states.push_back({ time, position, moving });
+        while (_states.size() > SIZE)
+            _states.pop_front();
+    }
+
+    paa::Vec2 InterpolationBuffer::sample(clock::time_point now) const
+    {
+        const double time = seconds(now) - delay();
+
+        if (_states.empty())
+            return paa::Vec2();
+        if (time <= _states.front().time)
+            return _states.front().position;
+
+        for (std::size_t i = 1; i < _states.size(); ++i) {
+            const State& from = _states[i - 1];
+            const State& to = _states[i];
+
+            if (time <= to.time) {
+                const double t = to.time > from.time
+                    ? (time - from.time) / (to.time - from.time)
+                    : 1;
+                return paa::Vec2(from.position.x + (to.position.x - from.position.x) * t,
+                    from.position.y + (to.position.y - from.position.y) * t);
+            }
+        }
+
+        const State& last = _states.back();
+        if (!last.moving || _states.size() < 2)
+            return last.position;
+
+        const State& previous = _states[_states.size() - 2];
+        const double dt = last.time - previous.time;
+        if (dt <= 0)
+            return last.position;
+        const double t = std::min(time - last.time, MAX_EXTRAPOLATION) / dt;
+        return paa::Vec2(last.position.x + (last.position.x - previous.position.x) * t,
+            last.position.y + (last.position.y - previous.position.y) * t);
+    }
+
+    double InterpolationBuffer::delay() const
+    {
+        return std::clamp(_delay + _interval + 2 * _jitter, MIN_DELAY, MAX_DELAY);
+    }
+
+    void InterpolationBuffer::clear() { _states.clear(); }
+
+}
+}
@@ -0,0 +1,57 @@
+#include "Prediction.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rtype {
+namespace game {
+
+    void PredictionHistory::record(
+        int dx, int dy, double dt, const paa::Vec2& position)
+    {
+        if (dx == 0 && dy == 0 && !_moves.empty()
+            && _moves.back().position.x == position.x
+            && _moves.back().position.y == position.y)
+            return;
+
+        _moves.push_back({ ++_tick, dx, dy, dt, position });
+        if (_moves.size() > SIZE)
+            _moves.pop_front();
+    }
+
+    bool PredictionHistory::reconcile(net::player_tick_t tick,
+        const paa::Vec2& corrected, const paa::Vec2& speed,
+        const paa::Vec2& max, paa::Vec2& position)
+    {
+        auto it = std::find_if(_moves.rbegin(), _moves.rend(),
+            [tick](const Move& move) { return move.tick == tick; });
+
+        if (it == _moves.rend())
+            return false; // Too old, a newer correction will come
+        auto base = std::prev(it.base());
+
+        // Moves older than the corrected one are not needed anymore
+        _moves.erase(_moves.begin(), base);
+        base = _moves.begin();
+
+        if (std::hypot(base->position.x - corrected.x,
+                base->position.y - corrected.y)
+            <= THRESHOLD)
+            return false;
+
+        position = corrected;
+        base->position = corrected;
+        for (auto move = std::next(base); move != _moves.end(); ++move) {
+            position.x = std::clamp(
+                position.x + move->dx * speed.x * move->dt, 0.0, max.x);
+            position.y = std::clamp(
+                position.y + move->dy * speed.y * move->dt, 0.0, max.y);
+            move->position = position;
+        }
+        return true;
+    }
+
+    void PredictionHistory::clear() { _moves.clear(); }
+
+}
+}
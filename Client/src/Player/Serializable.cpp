@@ -4,6 +4,11 @@
 namespace rtype {
 namespace game {
 
+    // The wire bounds of a position are integers, they must still cover
+    // the whole playfield
+    static_assert(RTYPE_PLAYER_STATE_MAX_X == RTYPE_PLAYFIELD_WIDTH);
+    static_assert(RTYPE_PLAYER_STATE_MAX_Y == RTYPE_PLAYFIELD_HEIGHT);
+
     SerializablePlayer::SerializablePlayer(const std::vector<net::Byte>& data)
     {
         from(data.data(), data.size());
@@ -21,37 +26,35 @@ namespace game {
         set_from_components(controller, position, health, id);
     }
 
-    std::vector<net::Byte> SerializablePlayer::serialize() const
-    {
-        net::Serializer s;
-        s << this->data;
-        s.add_bytes(pos.serialize());
-        return s.data;
-    }
-
-    void SerializablePlayer::from(
-        const net::Byte* data, const net::BufferSizeType size)
-    {
-        net::Serializer s(data, size);
-        s >> this->data;
-        pos.from(s.data.data(), s.data.size());
-    }
-
     void SerializablePlayer::set_from_components(
         const paa::Controller& controller, const paa::Position& pos,
         const paa::Health& health, const paa::Id& id)
+    {
+        set_pos(pos).set_hp(health.hp).set_input(controller);
+    }
+
+    SerializablePlayer& SerializablePlayer::set_input(
+        const paa::Controller& controller)
     {
         const paa::Vector2f xy = controller->getAxisXY();
 
-        set_pos(pos)
-            .set_hp(health.hp)
-            .set_move_left(xy.x < -20.f)
+        return set_move_left(xy.x < -20.f)
             .set_move_right(xy.x > 20.f)
             .set_move_up(xy.y < -20.f)
             .set_move_down(xy.y > 20.f)
             .set_shoot(controller->isButtonPressedOrHeld(RTYPE_SHOOT_BUTTON));
     }
 
+    void SerializablePlayer::simulate_input(paa::Controller& controller) const
+    {
+        controller->simulateAxisMovement(paa::Joystick::Axis::X,
+            get_move_left() ? -100 : get_move_right() ? 100 : 0);
+        controller->simulateAxisMovement(paa::Joystick::Axis::Y,
+            get_move_up() ? -100 : get_move_down() ? 100 : 0);
+        get_shoot() ? controller->simulateButtonHeld(RTYPE_SHOOT_BUTTON)
+                    : controller->simulateButtonIdle(RTYPE_SHOOT_BUTTON);
+    }
+
     void SerializablePlayer::set_from_entity(const PAA_ENTITY& e)
     {
         paa::DynamicEntity entity = e;
@@ -103,8 +106,8 @@ namespace game {
 
     SerializablePlayer& SerializablePlayer::set_pos(const paa::Position& pos)
     {
-        this->pos.x = static_cast<uint16_t>(pos.x - g_game.scroll);
-        this->pos.y = static_cast<uint16_t>(pos.y);
+        this->pos.x = static_cast<uint16_t>(std::max(pos.x - g_game.scroll, 0.));
+        this->pos.y = static_cast<uint8_t>(std::clamp(pos.y, 0., 255.));
         return *this;
     }
 
@@ -5,6 +5,12 @@
 #include "utils.hpp"
 #include "PileAA/MusicPlayer.hpp"
 #include "MenuParallax.hpp"
+#include "RServer/Feed/Lockstep.hpp"
+#include "RServer/Feed/StateHash.hpp"
+
+#include <fstream>
+#include <map>
+#include <sstream>
 
 using namespace rtype::net;
 
@@ -73,8 +79,11 @@ static void reinitialize_game()
 
     for (int i = 0; i < RTYPE_PLAYER_COUNT; i++) {
         if (g_game.connected_players[i]) {
-            paa::Controller c
-                = i == g_game.id ? new_keyboard() : new_simulated_controller();
+            // In lockstep mode every player is driven by the inputs of the
+            // session, the keyboard is only sampled
+            paa::Controller c = i == g_game.id && !g_game.lockstep_delay
+                ? new_keyboard()
+                : new_simulated_controller();
             g_game.players_entities[i]
                 = rtype::game::PlayerFactory::addPlayer(i, c);
             g_game.players_alive[i] = true;
@@ -86,10 +95,196 @@ static void reinitialize_game()
     }
 }
 
+// Lockstep mode: only the inputs of the players are exchanged and every
+// client simulates the whole game at a fixed timestep (see lockstep_session)
+static std::unique_ptr<lockstep_session> lockstep;
+static paa::Controller lockstep_keyboard;
+
+// State after each simulated tick that may still be loaded, from the last
+// confirmed one (the players, enemies, bullets and shooters are copied with
+// the registry, see SILVA_DEEP_CLONE)
+struct lockstep_state {
+    hl::silva::registry::saved_state ecs;
+    rtype::game::Map::Progress map;
+    std::array<rtype::net::Bool, RTYPE_PLAYER_COUNT> players_alive = { false };
+    std::unordered_map<int, PAA_ENTITY> enemies_to_entities;
+    float scroll = 0;
+    float old_scroll = 0;
+    float scroll_speed = DEFAULT_SCROLL_SPEED;
+    bool lock_scroll = false;
+    int score = 0;
+    int seed = 0;
+};
+
+static std::map<lockstep_tick_t, lockstep_state> lockstep_states;
+
+// Checksums of the state exchanged to detect that the simulations diverged
+static std::map<state_tick_t, std::string> desync_dumps;
+
+static void report_desync(PlayerID player, state_tick_t tick)
+{
+    spdlog::error("Lockstep: The simulation of player {} diverged from ours between ticks {} and {}",
+        player, tick - RTYPE_DESYNC_INTERVAL, tick);
+#ifdef RTYPE_DESYNC_DUMP
+    auto it = desync_dumps.find(tick);
+    if (it != desync_dumps.end()) {
+        const std::string file = "desync_" + std::to_string(g_game.id) + "_" + std::to_string(tick) + ".txt";
+        std::ofstream(file) << it->second;
+        spdlog::error("Lockstep: State of tick {} dumped in {}", tick, file);
+    }
+#endif
+}
+
+static desync_detector desync(report_desync);
+
+// Hash of what must be the same on every client: the entities, their
+// position and health, the scroll, the score and the random seed
+static uint64_t hash_world(std::string* dump)
+{
+    state_hash hash;
+    std::ostringstream ss;
+
+    for (auto&& [e, pos] : PAA_ECS.view<paa::Position>()) {
+        const int hp = PAA_ECS.has_component<paa::Health>(e)
+            ? PAA_ECS.get_component<paa::Health>(e).hp
+            : 0;
+
+        hash.add(e).add(pos.x).add(pos.y).add(hp);
+        if (dump)
+            ss << e << " " << pos.x << " " << pos.y << " " << hp << "\n";
+    }
+    hash.add(g_game.scroll).add(g_game.score).add(paa::Random::seed());
+    if (dump) {
+        ss << "scroll " << g_game.scroll << " score " << g_game.score
+           << " seed " << paa::Random::seed() << "\n";
+        *dump = ss.str();
+    }
+    return hash.value();
+}
+
+static void send_state_checksum(lockstep_tick_t tick)
+{
+#ifdef RTYPE_DESYNC_DUMP
+    std::string dump;
+    const uint64_t hash = hash_world(&dump);
+
+    desync_dumps[tick] = std::move(dump);
+    while (desync_dumps.size() > RTYPE_DESYNC_HISTORY)
+        desync_dumps.erase(desync_dumps.begin());
+#else
+    const uint64_t hash = hash_world(nullptr);
+#endif
+
+    desync.local(tick, hash);
+    g_game.service.udp().send(UpdateMessage(g_game.id,
+        state_checksum(tick, hash), message_code::STATE_CHECKSUM));
+}
+
+static void lockstep_save(lockstep_tick_t tick, const rtype::game::Map* map)
+{
+    lockstep_state& state = lockstep_states[tick];
+
+    state.ecs = PAA_ECS.save();
+    if (map != nullptr)
+        state.map = map->progress();
+    state.players_alive = g_game.players_alive;
+    state.enemies_to_entities = g_game.enemies_to_entities;
+    state.scroll = g_game.scroll;
+    state.old_scroll = g_game.old_scroll;
+    state.scroll_speed = g_game.scroll_speed;
+    state.lock_scroll = g_game.lock_scroll;
+    state.score = g_game.score;
+    state.seed = paa::Random::seed();
+}
+
+// The ticks that followed are simulated again and saved anew
+static void lockstep_load(lockstep_tick_t tick, rtype::game::Map* map)
+{
+    const lockstep_state& state = lockstep_states.at(tick);
+
+    PAA_ECS.restore(state.ecs);
+    if (map != nullptr)
+        map->restore(state.map);
+    g_game.players_alive = state.players_alive;
+    g_game.enemies_to_entities = state.enemies_to_entities;
+    g_game.scroll = state.scroll;
+    g_game.old_scroll = state.old_scroll;
+    g_game.scroll_speed = state.scroll_speed;
+    g_game.lock_scroll = state.lock_scroll;
+    g_game.score = state.score;
+    paa::Random::srand(state.seed);
+
+    g_game.reset_game_view();
+    g_game.game_view.move(g_game.scroll, 0);
+    lockstep_states.erase(lockstep_states.upper_bound(tick), lockstep_states.end());
+}
+
+// A confirmed tick is never simulated again, the older states are dropped
+static void lockstep_confirm(lockstep_tick_t tick)
+{
+    lockstep_states.erase(lockstep_states.begin(), lockstep_states.lower_bound(tick));
+    if (tick % RTYPE_DESYNC_INTERVAL == 0)
+        send_state_checksum(tick);
+}
+
+static lockstep_input_t lockstep_local_input()
+{
+    rtype::game::SerializablePlayer p;
+
+    p.set_input(lockstep_keyboard);
+    return p.data & rtype::game::SerializablePlayer::INPUT_MASK;
+}
+
+static void lockstep_step(lockstep_tick_t tick,
+    const lockstep_session::inputs_t& inputs, rtype::game::Map* map)
+{
+    for (int i = 0; i < RTYPE_PLAYER_COUNT; i++) {
+        if (!g_game.players_alive[i])
+            continue;
+        rtype::game::SerializablePlayer p;
+        paa::DynamicEntity e = g_game.players_entities[i];
+
+        p.data = inputs[i];
+        try {
+            p.simulate_input(e.getComponent<paa::Controller>());
+        } catch (...) {
+            spdlog::warn("Lockstep: Player {} has no controller", i);
+        }
+    }
+
+    PAA_DELTA_TIMER.setDeltaTime(lockstep->timestep());
+    paa::Timer::beginSimulation(tick * lockstep->timestep() * 1000);
+    if (map != nullptr)
+        scroll_map(*map);
+    PAA_ECS.update();
+    paa::Timer::endSimulation();
+}
+
+static void lockstep_send(const lockstep_input& input)
+{
+    g_game.service.udp().send(
+        UpdateMessage(g_game.id, input, message_code::LOCKSTEP_INPUT));
+}
+
+static void update_lockstep_input(PlayerID sid, const lockstep_input& input)
+{
+    if (lockstep)
+        lockstep->receive(sid, input);
+}
+
+static void update_state_checksum(PlayerID sid, const state_checksum& checksum)
+{
+    if (lockstep)
+        desync.remote(sid, checksum);
+}
+
+static void register_server_event_handlers();
+
 PAA_START_CPP(game_scene)
 {
     map_index = 0;
 
+    register_server_event_handlers();
     reinitialize_game();
 
     g_game.launch_transition();
@@ -111,6 +306,11 @@ PAA_START_CPP(game_scene)
 
 PAA_END_CPP(game_scene)
 {
+    lockstep = nullptr;
+    lockstep_states.clear();
+    paa::App::fixedTimestep = false;
+    if (g_game.service.client != nullptr)
+        g_game.service.inbox().reset();
     for (int i = 0; i < RTYPE_PLAYER_COUNT; i++) {
         if (g_game.players_entities[i]) {
             g_game.players_entities[i] = PAA_ENTITY();
@@ -122,24 +322,41 @@ PAA_END_CPP(game_scene)
     map = nullptr;
 }
 
-static void update_player_position(shared_message_t& msg)
+// Snapshots of the other players relayed by the server (by player id)
+static std::array<snapshot_decoder<rtype::game::SerializablePlayer>,
+    RTYPE_PLAYER_COUNT> player_snapshots;
+
+// Input frames already received from the other players (by player id)
+static std::array<input_receiver, RTYPE_PLAYER_COUNT> player_inputs;
+
+static void update_player_position(PlayerID sid, const player_update& u)
 {
-    const auto sp = parse_message<UpdateMessage>(msg);
-    const rtype::game::SerializablePlayer p(sp->data());
-    paa::DynamicEntity e = g_game.players_entities[sp->sid()];
+    rtype::game::SerializablePlayer p;
+
+    if (sid >= RTYPE_PLAYER_COUNT)
+        return;
+    // The inputs do not depend on a baseline, they are used even if the
+    // snapshot cannot be decoded
+    const auto inputs = player_inputs[sid].receive(u.inputs);
+    const bool decoded = player_snapshots[sid].decode(u.snapshot, p);
+    paa::DynamicEntity e = g_game.players_entities[sid];
     try {
-        e.getComponent<rtype::game::Player>()->update_info(p);
+        auto& player = e.getComponent<rtype::game::Player>();
+        player->replay_inputs(inputs);
+        if (!decoded)
+            return;
+        // The state of the local player can only be a correction
+        if (sid == g_game.id)
+            player->reconcile(p);
+        else
+            player->update_info(p);
     } catch (...) {
         spdlog::warn("You tried to update a dead or disconnected player");
     }
 }
 
-static void update_enemy_death(shared_message_t& msg)
+static void update_enemy_death(PlayerID sid, const SerializedEnemyDeath& e)
 {
-    const auto sp = parse_message<UpdateMessage>(msg);
-    SerializedEnemyDeath e;
-    e.from(sp->data().data(), sp->data().size());
-
     auto it = g_game.enemies_to_entities.find(e.getElement());
     if (it != g_game.enemies_to_entities.end()) {
         PAA_ECS.kill_entity(it->second);
@@ -147,25 +364,15 @@ static void update_enemy_death(shared_message_t& msg)
     }
 }
 
-static void update_player_death(shared_message_t& msg)
+static void update_player_death(PlayerID sid, const SerializedPlayerDeath& e)
 {
-    const auto sp = parse_message<UpdateMessage>(msg);
-    SerializedPlayerDeath e;
-    e.from(sp->data().data(), sp->data().size());
-
     PAA_ECS.kill_entity(g_game.players_entities[e.getElement()]);
     g_game.players_alive[e.getElement()] = false;
     spdlog::debug("Player {} is dead", e.getElement());
 }
 
-static void update_sync_scroll(shared_message_t& msg)
+static void update_sync_scroll(PlayerID sid, const SerializedScroll& s)
 {
-    const auto sync = parse_message<UpdateMessage>(msg);
-    SerializedScroll s;
-    s.from(sync->data().data(), sync->data().size());
-
-    auto current_scroll = g_game.scroll;
-
     g_game.scroll = s.getElement();
     g_game.old_scroll = g_game.old_scroll >= g_game.scroll_speed ? (g_game.scroll - g_game.scroll_speed) : 0;
 
@@ -173,51 +380,72 @@ static void update_sync_scroll(shared_message_t& msg)
     g_game.game_view.move(g_game.scroll, 0);
 }
 
-static void update_player_room_client_disconnect(shared_message_t& msg)
+static void update_player_room_client_disconnect(const UserDisconnectFromRoom& sp)
 {
-    const auto sp = parse_message<UserDisconnectFromRoom>(msg);
-
     spdlog::warn("User {} disconnected from the room, new host is {}",
-                sp->get_disconnected_user_id(), sp->get_new_host_id());
+                sp.get_disconnected_user_id(), sp.get_new_host_id());
 
-    g_game.connected_players[sp->get_disconnected_user_id()] = false;
-    g_game.players_alive[sp->get_disconnected_user_id()] = false;
-    PAA_ECS.kill_entity(g_game.players_entities[sp->get_disconnected_user_id()]);
-    g_game.players_entities[sp->get_disconnected_user_id()] = PAA_ENTITY();
+    g_game.connected_players[sp.get_disconnected_user_id()] = false;
+    g_game.players_alive[sp.get_disconnected_user_id()] = false;
+    PAA_ECS.kill_entity(g_game.players_entities[sp.get_disconnected_user_id()]);
+    g_game.players_entities[sp.get_disconnected_user_id()] = PAA_ENTITY();
+    if (lockstep)
+        lockstep->remove_player(sp.get_disconnected_user_id());
 
-    if (sp->get_new_host_id() == g_game.id) {
+    if (sp.get_new_host_id() == g_game.id) {
         spdlog::warn("You are the new host");
         g_game.is_host = true;
     }
 }
 
+static void register_server_event_handlers()
+{
+    auto& inbox = g_game.service.inbox();
+
+    for (auto& snapshots : player_snapshots)
+        snapshots.reset();
+    for (auto& inputs : player_inputs)
+        inputs.reset();
+
+    inbox.on_update<SerializedEnemyDeath>(message_code::UPDATE_ENEMY_DESTROYED, update_enemy_death);
+    inbox.on_update<SerializedPlayerDeath>(message_code::UPDATE_PLAYER_DESTROYED, update_player_death);
+    inbox.on_update<player_update>(message_code::UPDATE_PLAYER, update_player_position);
+    inbox.on_update<SerializedScroll>(message_code::UPDATE_SCROLL, update_sync_scroll);
+    inbox.on_update<lockstep_input>(message_code::LOCKSTEP_INPUT, update_lockstep_input);
+    inbox.on_update<state_checksum>(message_code::STATE_CHECKSUM, update_state_checksum);
+    inbox.on<UserDisconnectFromRoom>(message_code::ROOM_CLIENT_DISCONNECT, update_player_room_client_disconnect);
+}
+
 static void update_server_event()
 {
     auto& tcp = g_game.service.tcp();
     auto& udp = g_game.service.udp();
 
+    // Everything the game cares about is routed through the inbox,
+    // what is left in the queues is dropped
     shared_message_t msg;
-    while (tcp.poll(msg) || udp.poll(msg)) {
-        switch (msg->code()) {
-        case message_code::UPDATE_ENEMY_DESTROYED:
-            update_enemy_death(msg);
-            break;
-        case message_code::UPDATE_PLAYER_DESTROYED:
-            update_player_death(msg);
-            break;
-        case message_code::UPDATE_PLAYER:
-            update_player_position(msg);
-            break;
-        case message_code::UPDATE_SCROLL:
-            update_sync_scroll(msg);
-            break;
-        case message_code::ROOM_CLIENT_DISCONNECT:
-            update_player_room_client_disconnect(msg);
-            break;
-        default:
-            break;
-        }
-    }
+    while (tcp.poll(msg) || udp.poll(msg))
+        ;
+    g_game.service.inbox().drain();
+}
+
+// Every map starts a new session from its first tick
+static void start_lockstep(std::unique_ptr<rtype::game::Map>& map)
+{
+    lockstep_keyboard = new_keyboard();
+    desync.reset();
+    desync_dumps.clear();
+    lockstep_states.clear();
+    lockstep = std::make_unique<lockstep_session>(g_game.id,
+        g_game.connected_players, g_game.lockstep_delay,
+        lockstep_session::callbacks { lockstep_local_input,
+            [&map](lockstep_tick_t tick, const lockstep_session::inputs_t& inputs) {
+                lockstep_step(tick, inputs, map.get());
+            },
+            [&map](lockstep_tick_t tick) { lockstep_save(tick, map.get()); },
+            [&map](lockstep_tick_t tick) { lockstep_load(tick, map.get()); },
+            lockstep_confirm, lockstep_send });
+    paa::App::fixedTimestep = true;
 }
 
 static void handle_transition(unsigned int& map_index, std::unique_ptr<rtype::game::Map>& map)
@@ -230,10 +458,16 @@ static void handle_transition(unsigned int& map_index, std::unique_ptr<rtype::ga
                 return;
             }
             if ((map == nullptr || map->changes())) {
+                // In lockstep mode the timers of the new map start at tick 0
+                if (g_game.lockstep_delay)
+                    paa::Timer::beginSimulation(0);
                 reinitialize_game();
                 map = load_next_map(map_index);
+                paa::Timer::endSimulation();
                 if (map == nullptr) {
                     PAA_SET_SCENE(game_win);
+                } else if (g_game.lockstep_delay) {
+                    start_lockstep(map);
                 }
             }
         }
@@ -252,8 +486,14 @@ PAA_UPDATE_CPP(game_scene)
     handle_transition(map_index, map);
 
     //spdlog::info("Scroll: {}", g_game.scroll);
-    if (map != nullptr)
+    if (lockstep) {
+        const double dt = PAA_DELTA_TIMER.getDeltaTime();
+
+        lockstep->update(dt);
+        PAA_DELTA_TIMER.setDeltaTime(dt);
+    } else if (map != nullptr) {
         scroll_map(*map);
+    }
 
     g_game.use_hud_view();
 
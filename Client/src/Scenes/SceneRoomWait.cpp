@@ -50,6 +50,7 @@ static void manage_launch_game(shared_message_t msg)
         return;
     } else if (rep->yes()) {
         paa::Random::srand(rep->seed());
+        g_game.lockstep_delay = rep->lockstep_delay();
         spdlog::info("Client: Launching game");
         paa::GMusicPlayer::play("../assets/launch_game.ogg", false);
         PAA_SET_SCENE(game_scene);
@@ -22,7 +22,9 @@ public:
     using AnimationRegister = std::unordered_map<std::string, Animation>;
 
 private:
-    AnimationRegister _reg;
+    // Shared by the copies of the sprite until one of them registers an
+    // animation (copying a sprite does not copy its animations)
+    std::shared_ptr<AnimationRegister> _reg;
     Animation* _currentAnimation = nullptr;
     Timer _timer;
     unsigned int _animationIndex = 0;
@@ -59,6 +61,12 @@ public:
      */
     AnimatedSprite& useAnimation(const std::string& animationName, bool loop=true);
 
+    /**
+     * @brief Restart the current animation from its first frame
+     * @return *this
+     */
+    AnimatedSprite& restartAnimation();
+
     /**
      * @brief Update the animation
      */
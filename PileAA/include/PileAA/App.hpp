@@ -10,6 +10,7 @@
 #include "BaseComponents.hpp"
 #include "BatchRenderer.hpp"
 #include "InputHandler.hpp"
+#include "Prefab.hpp"
 #include "ResourceManager.hpp"
 #include "Timer.hpp"
 
@@ -54,6 +55,16 @@ private:
 public:
     static inline nlohmann::json gameConfig;
     static inline bool fullscreen = false;
+    // When set the main loop does not update the ECS, the scene steps it
+    // itself (fixed timestep simulation)
+    static inline bool fixedTimestep = false;
+    // Built without a window, a GL context nor an audio device
+    // (pileaa_headless)
+#ifdef PILEAA_HEADLESS
+    static constexpr bool headless = true;
+#else
+    static constexpr bool headless = false;
+#endif
 
     ~App() = default;
 
@@ -84,6 +95,9 @@ public:
 
     /**
      * @brief Starts the app
+     *        In a headless build nothing is drawn and no event is received,
+     *        the loop runs at the fps of the configuration (as fast as it
+     *        can with 0) until stop() is called
      */
     bool run();
 
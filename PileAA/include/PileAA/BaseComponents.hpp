@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AnimatedSprite.hpp"
+#include "Pool.hpp"
 #include "QuadTree.hpp"
 #include "external/HelifeWasTaken/Silva"
 
@@ -79,3 +80,10 @@ PAA_SINGLE_INTEGER_COMPONENT(Health, hp);
 void setup_ecs(hl::silva::registry& r);
 
 }
+
+// The plain components are part of the snapshots of the registry
+SILVA_SNAPSHOT(paa::Position);
+SILVA_SNAPSHOT(paa::Velocity);
+SILVA_SNAPSHOT(paa::Depth);
+SILVA_SNAPSHOT(paa::Id);
+SILVA_SNAPSHOT(paa::Health);
@@ -23,7 +23,6 @@ public:
     using registry_t = hl::silva::registry;
     using entity_t = hl::silva::Entity;
     using entity_id_t = hl::silva::Entity::Id;
-    using component_t = hl::silva::registry::anonymous_t;
 
 private:
     hl::silva::registry& _registry = EcsInstance::get();
@@ -202,6 +201,18 @@ public:
         return getComponent<paa::Sprite>();
     }
 
+    /**
+     * @brief Attach a copy of the sprite of a prefab to the entity
+     *        (This also attach a Depth component of 0 for the z-index)
+     * @return The sprite
+     */
+    Sprite& attachSprite(const Prefab& prefab)
+    {
+        insertComponent(prefab.makeSprite());
+        emplaceComponent<Depth>(0);
+        return getComponent<paa::Sprite>();
+    }
+
     /**
      * @brief Attach a position component to the entity
      * @return The position
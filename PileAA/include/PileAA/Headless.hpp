@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <string>
+
+namespace paa {
+
+/**
+ * @brief Stands for the window of the app in a headless build
+ *        (PILEAA_HEADLESS): it never opens a window nor creates a GL
+ *        context, draws nothing and receives no event
+ *        The framerate limit is still honored by display()
+ */
+class NullWindow {
+private:
+    bool _open = false;
+    std::string _title;
+    sf::Vector2u _size;
+    sf::View _defaultView;
+    sf::View _view;
+    sf::Time _frameTime = sf::Time::Zero;
+    sf::Clock _clock;
+
+public:
+    NullWindow() = default;
+    ~NullWindow() = default;
+
+    void create(sf::VideoMode mode, const std::string& title,
+        sf::Uint32 style = sf::Style::Default)
+    {
+        (void)style;
+        _open = true;
+        _title = title;
+        _size = sf::Vector2u(mode.width, mode.height);
+        _defaultView.reset(sf::FloatRect(0, 0, mode.width, mode.height));
+        _view = _defaultView;
+        _clock.restart();
+    }
+
+    void close() { _open = false; }
+
+    bool isOpen() const { return _open; }
+
+    bool pollEvent(sf::Event& event)
+    {
+        (void)event;
+        return false;
+    }
+
+    void setFramerateLimit(unsigned int limit)
+    {
+        _frameTime = limit ? sf::seconds(1.f / limit) : sf::Time::Zero;
+    }
+
+    void setTitle(const std::string& title) { _title = title; }
+
+    sf::Vector2u getSize() const { return _size; }
+
+    void setView(const sf::View& view) { _view = view; }
+
+    const sf::View& getView() const { return _view; }
+
+    const sf::View& getDefaultView() const { return _defaultView; }
+
+    void clear(const sf::Color& color = sf::Color::Black) { (void)color; }
+
+    void draw(const sf::Drawable& drawable,
+        const sf::RenderStates& states = sf::RenderStates::Default)
+    {
+        (void)drawable;
+        (void)states;
+    }
+
+    void display()
+    {
+        if (_frameTime != sf::Time::Zero) {
+            sf::sleep(_frameTime - _clock.getElapsedTime());
+            _clock.restart();
+        }
+    }
+};
+
+}
@@ -2,8 +2,40 @@
 
 #include "Types.hpp"
 
+#include <filesystem>
+
 namespace paa
 {
+#ifdef PILEAA_HEADLESS
+    /**
+     * @brief Music player of a headless build, it opens no audio device
+     *        and only tells if the music could have been played
+     */
+    class MusicPlayer
+    {
+    public:
+        MusicPlayer() = default;
+        ~MusicPlayer() = default;
+
+        bool play(const std::string& path, bool vloop=true)
+        {
+            (void)vloop;
+            return std::filesystem::exists(path);
+        }
+
+        void pause() {}
+
+        void stop() {}
+
+        void loop(bool vloop) { (void)vloop; }
+
+        void setLoopPoints(double start_sec, double length_sec)
+        {
+            (void)start_sec;
+            (void)length_sec;
+        }
+    };
+#else
     class MusicPlayer
     {
     private:
@@ -43,6 +75,7 @@ namespace paa
             _music.setLoopPoints(t);
         }
     };
+#endif
 
     class GMusicPlayer
     {
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Count of blocks a pool allocates at once when its free list is empty
+#ifndef PAA_POOL_CHUNK
+#define PAA_POOL_CHUNK 64
+#endif
+
+namespace paa {
+
+/**
+ * @brief Blocks of memory of the size of T, handed out from a free list
+ *        The blocks are allocated PAA_POOL_CHUNK at a time and are never
+ *        given back to the system, a released block is reused by the next
+ *        allocation of the same type (thread safe)
+ */
+template <typename T> class Pool {
+private:
+    union Block {
+        Block* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    std::mutex _mutex;
+    Block* _free = nullptr;
+    std::vector<std::unique_ptr<Block[]>> _chunks;
+    std::size_t _available = 0;
+
+    void grow()
+    {
+        auto& chunk = _chunks.emplace_back(new Block[PAA_POOL_CHUNK]);
+
+        for (std::size_t i = 0; i < PAA_POOL_CHUNK; ++i) {
+            chunk[i].next = _free;
+            _free = &chunk[i];
+        }
+        _available += PAA_POOL_CHUNK;
+    }
+
+public:
+    Pool() = default;
+    ~Pool() = default;
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /**
+     * @brief Get the pool of a type
+     *        (It is never destroyed so that the objects released at exit
+     *        can still go back to it)
+     */
+    static Pool& get()
+    {
+        static Pool* pool = new Pool;
+        return *pool;
+    }
+
+    /**
+     * @brief Get a block for one T (not constructed)
+     */
+    T* allocate()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (!_free)
+            grow();
+        Block* block = _free;
+        _free = block->next;
+        --_available;
+        return reinterpret_cast<T*>(block->storage);
+    }
+
+    /**
+     * @brief Give back a block obtained from allocate (already destroyed)
+     */
+    void deallocate(T* ptr)
+    {
+        Block* block = reinterpret_cast<Block*>(ptr);
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        block->next = _free;
+        _free = block;
+        ++_available;
+    }
+
+    /**
+     * @brief Get the count of blocks allocated from the system
+     */
+    std::size_t capacity()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _chunks.size() * PAA_POOL_CHUNK;
+    }
+
+    /**
+     * @brief Get the count of blocks that are free
+     */
+    std::size_t available()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _available;
+    }
+};
+
+/**
+ * @brief Allocator that takes single objects from the Pool of their type
+ *        (Arrays go through operator new, they are not pooled)
+ */
+template <typename T> struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template <typename U> PoolAllocator(const PoolAllocator<U>&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+        if (n == 1)
+            return Pool<T>::get().allocate();
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n)
+    {
+        if (n == 1)
+            Pool<T>::get().deallocate(ptr);
+        else
+            std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template <typename U> bool operator==(const PoolAllocator<U>&) const
+    {
+        return true;
+    }
+};
+
+/**
+ * @brief Make a shared pointer whose object and counters sit in one block
+ *        of a Pool, the block goes back to the pool when the last pointer
+ *        is released (when the entity holding it is killed for components)
+ *
+ * @param args The arguments of the constructor of T
+ * @return The shared pointer
+ */
+template <typename T, typename... Args>
+static inline std::shared_ptr<T> make_pooled(Args&&... args)
+{
+    return std::allocate_shared<T>(
+        PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "AnimatedSprite.hpp"
+#include "BaseComponents.hpp"
+#include "meta.hpp"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace paa {
+
+/**
+ * @brief What every entity of one type starts with, resolved once:
+ *        its sprite (texture, animations and current animation), the bounds
+ *        of the sprite and its default components
+ *        Instantiating a prefab copies them without looking up any name
+ */
+class Prefab {
+public:
+    using setup_t = std::function<void(AnimatedSprite&)>;
+    using component_init_t = std::function<void(
+        hl::silva::registry&, const hl::silva::Entity&)>;
+
+private:
+    AnimatedSprite _sprite;
+    FloatRect _bounds;
+    std::vector<component_init_t> _components;
+
+public:
+    HL_SUB_ERROR_IMPL(Error, AABaseError);
+
+    /**
+     * @brief Construct a new Prefab object
+     * @param textureName The texture of the sprite (with the animations
+     *        registered for it)
+     * @param setup Called on the sprite once it has its animations
+     *        (choose the animation, scale it...)
+     */
+    Prefab(const std::string& textureName, const setup_t& setup = nullptr);
+
+    ~Prefab() = default;
+
+    /**
+     * @brief Setup that only chooses the animation of the sprite
+     * @param animationName Animation name
+     * @param loop Whether the animation loops
+     */
+    static setup_t animation(const std::string& animationName, bool loop = true);
+
+    /**
+     * @brief Give a default component to the instances
+     * @param component The value they get a copy of
+     * @return *this
+     */
+    template <typename Component> Prefab& with(const Component& component)
+    {
+        _components.emplace_back(
+            [component](hl::silva::registry& r, const hl::silva::Entity& e) {
+                r.emplace<Component>(e, component);
+            });
+        return *this;
+    }
+
+    /**
+     * @brief Get the bounds of the sprite of an instance
+     * @param position The position of the instance
+     * @return The bounds (before any rotation)
+     */
+    IntRect getBounds(const Position& position) const;
+
+    /**
+     * @brief Make a copy of the sprite, its animation starts over
+     * @return The sprite
+     */
+    Sprite makeSprite() const;
+
+    /**
+     * @brief Spawn an entity with a Position, a copy of the sprite, a Depth
+     *        of 0 and the default components
+     * @return The entity
+     */
+    hl::silva::Entity instantiate(
+        hl::silva::registry& r, const Position& position) const;
+};
+
+class PrefabRegister {
+public:
+    PrefabRegister() = default;
+    ~PrefabRegister() = default;
+
+    /**
+     * @brief Register a prefab (replaces the one with the same name)
+     * @return The prefab, its address stays valid until clear is called
+     *         (keep it instead of looking it up for every spawn)
+     */
+    Prefab& addPrefab(const std::string& name, Prefab prefab);
+
+    /**
+     * @brief Get a prefab, throws a Prefab::Error if it does not exist
+     */
+    const Prefab& getPrefab(const std::string& name) const;
+
+    bool hasPrefab(const std::string& name) const;
+
+    /**
+     * @brief Forget every prefab (before the textures are unloaded)
+     */
+    void clear();
+
+private:
+    std::unordered_map<std::string, Prefab> _prefabs;
+};
+
+/**
+ * @brief Construct a new hl singleton impl object
+ *
+ */
+HL_SINGLETON_IMPL(PrefabRegister, PrefabRegisterInstance);
+
+}
@@ -18,6 +18,13 @@ public:
      */
     static void srand(const int& seed) { _seed = seed; }
 
+    /**
+     * @brief Gets the current seed (to restore it later with srand)
+     *
+     * @return int
+     */
+    static int seed() { return _seed; }
+
     /**
      * @brief Returns a random number between INT_MIN and INT_MAX
      *
@@ -25,6 +25,13 @@ private:
         = std::unordered_map<std::string, std::unique_ptr<LoadableResource>>;
 
     ResourceHolder _resourceMap;
+    std::unordered_map<std::string, std::string> _paths;
+
+#ifdef PILEAA_HEADLESS
+    // Textures and sounds need a GL context and an audio device, only what
+    // is known about them without one is kept
+    std::unordered_map<std::string, Vector2u> _textureSizes;
+#endif
 
     static inline const char* DEFAULT_TEXTURE
         = "__paa_resource_manager_default_texture__";
@@ -37,7 +44,9 @@ public:
      */
     ResourceManager()
     {
+#ifndef PILEAA_HEADLESS
         copyAs(DEFAULT_TEXTURE, FrameBuffer::generateDefaultTexture());
+#endif
         copyAs(DEFAULT_IMAGE, FrameBuffer::generateDefaultImage());
     }
 
@@ -68,6 +77,20 @@ public:
     void load(const std::string& filename, const std::string& name,
         LoadArgs&&... loadArgs)
     {
+        _paths[name] = filename;
+#ifdef PILEAA_HEADLESS
+        if constexpr (std::is_same_v<T, Texture>) {
+            Image image;
+
+            if (!image.loadFromFile(filename))
+                spdlog::error(
+                    "ResourceHolder::load - Failed to load \"{}\"", filename);
+            _textureSizes[name] = image.getSize();
+            return;
+        } else if constexpr (std::is_same_v<T, SoundBuffer>) {
+            return;
+        }
+#endif
         LoadableResource* resource = new LoadableResource(T());
         T& ref = std::get<T>(*resource);
 
@@ -98,6 +121,14 @@ public:
      */
     template <typename T> T& get(const std::string& name)
     {
+#ifdef PILEAA_HEADLESS
+        if constexpr (std::is_same_v<T, Texture>
+            || std::is_same_v<T, SoundBuffer>) {
+            throw ResourceManagerError(
+                "ResourceHolder::get - Not available in a headless build: "
+                + name);
+        }
+#endif
         auto found = _resourceMap.find(name);
         if (found == _resourceMap.end()) {
             if constexpr (std::is_same_v<T, Texture>) {
@@ -118,6 +149,29 @@ public:
         return std::get<T>(*found->second);
     }
 
+    /**
+     * @brief Tells you if a resource of a specific name was loaded
+     *
+     * @param name The name of the resource
+     */
+    bool has(const std::string& name) const;
+
+    /**
+     * @brief Get the file a resource was loaded from
+     *
+     * @param name The name of the resource
+     * @return const std::string& The path given to load
+     */
+    const std::string& getPath(const std::string& name) const;
+
+    /**
+     * @brief Get the size of a texture, even in a headless build
+     *        (the size of the default texture if it was not loaded)
+     *
+     * @param name The name of the texture
+     */
+    Vector2u getTextureSize(const std::string& name);
+
     /**
      * @brief Remove a resource of a specific name
      *
@@ -5,21 +5,47 @@
 namespace paa {
 using TimeUnit = f64;
 
-class Timer : public Clock {
+/**
+ * @brief Counts the time since it was (re)started
+ *        A timer restarted while a simulation step runs (see beginSimulation)
+ *        counts the simulated time instead of the real one: it only depends
+ *        on the simulated ticks and it is copied with the object that holds
+ *        it
+ */
+class Timer {
 protected:
     TimeUnit _targetTime = 0.0;
+    TimeUnit _start = 0.0; // In milliseconds
+    bool _simulated = false;
+
+    static inline bool _simulating = false;
+    static inline TimeUnit _simulationTime = 0.0;
+
+    TimeUnit now() const;
 
 public:
     /**
      * @brief Construct a new Timer object
      */
-    Timer() = default;
+    Timer();
 
     /**
      * @brief Destroy the Timer object
      */
     ~Timer() = default;
 
+    /**
+     * @brief Get the time elapsed since the timer was (re)started
+     */
+    sf::Time getElapsedTime() const;
+
+    /**
+     * @brief Restart the timer
+     *
+     * @return sf::Time The time elapsed until then
+     */
+    sf::Time restart();
+
     /**
      * @brief Checks whether the target has been reached by the clock
      */
@@ -45,6 +71,17 @@ public:
         return capped ? std::min(f, 1.0) : f;
     }
 
+    /**
+     * @brief The timers restarted until endSimulation count the simulated
+     *        time, set to the given time (in milliseconds)
+     */
+    static void beginSimulation(const TimeUnit& time);
+
+    /**
+     * @brief The timers restarted from now on count the real time again
+     *        (the simulated time stops)
+     */
+    static void endSimulation();
 };
 
 class DeltaTimer : public Clock {
@@ -74,6 +111,14 @@ public:
      * @brief Update the Delta Time object
      */
     void update();
+
+    /**
+     * @brief Overrides the delta time until the next update
+     *        (to step a simulation at a fixed timestep)
+     *
+     * @param deltaTime
+     */
+    void setDeltaTime(const TimeUnit& deltaTime);
 };
 
 } // namespace paa
@@ -5,6 +5,10 @@
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 
+#ifdef PILEAA_HEADLESS
+#include "Headless.hpp"
+#endif
+
 namespace paa {
 
 using u8 = std::uint8_t;
@@ -45,8 +49,13 @@ using Music = sf::Music;
 using Image = sf::Image;
 using Drawable = sf::Drawable;
 using Transformable = sf::Transformable;
+#ifdef PILEAA_HEADLESS
+using RenderWindow = NullWindow;
+using Window = NullWindow;
+#else
 using RenderWindow = sf::RenderWindow;
 using Window = sf::RenderWindow;
+#endif
 using Vertex = sf::Vertex;
 using VertexArray = sf::VertexArray;
 using RenderStates = sf::RenderStates;
@@ -35,6 +35,11 @@
  */
 #define PAA_ANIMATION_REGISTER paa::AnimationRegisterInstance::get()
 
+/**
+ * @brief Gets the prefab register
+ */
+#define PAA_PREFAB_REGISTER paa::PrefabRegisterInstance::get()
+
 /**
  * @brief Gets the batch renderer
  */
@@ -12,7 +12,16 @@ void AnimatedSprite::_setRect(const unsigned int& index)
 }
 
 AnimatedSprite::AnimatedSprite(const std::string& textureName)
+    : _reg(std::make_shared<AnimationRegister>())
 {
+#ifdef PILEAA_HEADLESS
+    // No texture is bound, the rects still give the bounds of the sprite
+    auto& resources = ResourceManagerInstance::get();
+    const Vector2u size = resources.getTextureSize(textureName);
+    const IntRect rect(0, 0, size.x, size.y);
+
+    _uses_default = !resources.has(textureName);
+#else
     auto& tx = ResourceManagerInstance::get().get<sf::Texture>(textureName);
     const auto& def = ResourceManagerInstance::get().getDefaultTexture();
 
@@ -22,6 +31,7 @@ AnimatedSprite::AnimatedSprite(const std::string& textureName)
         0, 0, getTexture()->getSize().x, getTexture()->getSize().y);
 
     _uses_default = &tx == &def;
+#endif
     registerAnimation("DEFAULT", paa::Animation { { rect }, 1000000.f });
     useAnimation("DEFAULT");
     setPosition(0, 0);
@@ -30,7 +40,18 @@ AnimatedSprite::AnimatedSprite(const std::string& textureName)
 void AnimatedSprite::registerAnimation(
     const std::string& animationName, const Animation& animation)
 {
-    _reg[animationName] = animation;
+    if (_reg.use_count() > 1) {
+        auto reg = std::make_shared<AnimationRegister>(*_reg);
+
+        for (auto& [name, anim] : *_reg) {
+            if (&anim == _currentAnimation) {
+                _currentAnimation = &(*reg)[name];
+                break;
+            }
+        }
+        _reg = std::move(reg);
+    }
+    (*_reg)[animationName] = animation;
 }
 
 AnimatedSprite& AnimatedSprite::useAnimation(const std::string& animationName,
@@ -38,9 +59,9 @@ AnimatedSprite& AnimatedSprite::useAnimation(const std::string& animationName,
 {
     try {
         if (_uses_default)
-            _currentAnimation = &_reg.at("DEFAULT");
+            _currentAnimation = &_reg->at("DEFAULT");
         else
-            _currentAnimation = &_reg.at(animationName);
+            _currentAnimation = &_reg->at(animationName);
     } catch (...) {
         spdlog::warn("PileAA::AnimatedSprite: Could not find animtion: [{}] "
                      "using default",
@@ -53,6 +74,12 @@ AnimatedSprite& AnimatedSprite::useAnimation(const std::string& animationName,
     return *this;
 }
 
+AnimatedSprite& AnimatedSprite::restartAnimation()
+{
+    _setRect(0);
+    return *this;
+}
+
 bool AnimatedSprite::isLastFrame() const
 {
     return _animationIndex == _currentAnimation->rects.size() - 1;
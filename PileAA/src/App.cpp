@@ -7,6 +7,7 @@
 #include "PileAA/MusicPlayer.hpp"
 
 #include <fstream>
+#include <thread>
 
 #include <spdlog/spdlog.h>
 
@@ -41,7 +42,9 @@ bool App::run()
     auto& batch = paa::BatchRendererInstance::get();
     auto& delta = paa::DeltaTimerInstance::get();
 
+#ifndef PILEAA_HEADLESS
     sf::Clock imGUIDeltaClock;
+#endif
 
     spdlog::info("PileAA: Starting main loop");
 
@@ -60,20 +63,27 @@ bool App::run()
                 return true;
             }
 
+#ifndef PILEAA_HEADLESS
             ImGui::SFML::ProcessEvent(event);
+#endif
 
             input.eventUpdate(event);
 
             scene.handleEvent();
         }
 
+#ifndef PILEAA_HEADLESS
         ImGui::SFML::Update(window, imGUIDeltaClock.restart());
+#endif
 
         window.clear();
-        ecs.update();
+        if (!fixedTimestep)
+            ecs.update();
         batch.render(window);
         scene.update();
+#ifndef PILEAA_HEADLESS
         ImGui::SFML::Render(window);
+#endif
         window.display();
     }
     return false;
@@ -143,9 +153,11 @@ static inline void load_configuration_file_animations(nlohmann::json& json)
                 = animation["texture"].get<std::string>();
             spdlog::info("PileAA: Loading animation: {}", spriteSheetName);
             try {
-                resourceManager.get<Texture>(
-                    spriteSheetName); // Check if the texture exists
-                spdlog::info("PileAA: Texture {} exists", spriteSheetName);
+                if (resourceManager.has(spriteSheetName))
+                    spdlog::info("PileAA: Texture {} exists", spriteSheetName);
+                else
+                    spdlog::warn("PileAA: Texture {} does not exist",
+                        spriteSheetName);
                 for (const auto& frames : animation["frames"]) {
                     const auto& animationName
                         = frames["name"].get<std::string>();
@@ -178,6 +190,24 @@ static inline void load_configuration_file_animations(nlohmann::json& json)
     spdlog::info("PileAA: Animations loaded");
 }
 
+static inline void create_screen(
+    const VideoMode& mode, const std::string& title, bool fullscreen)
+{
+    auto& screen = Screen::get();
+
+#ifdef PILEAA_HEADLESS
+    // There is no display to go fullscreen on
+    (void)fullscreen;
+    screen.create(mode, title);
+#else
+    if (fullscreen) {
+        screen.create(VideoMode::getFullscreenModes()[0], title, sf::Style::Fullscreen);
+    } else {
+        screen.create(mode, title, sf::Style::Close);
+    }
+#endif
+}
+
 static inline void load_configuration_file_window(nlohmann::json& json, bool fullscreen = false)
 {
     spdlog::info("PileAA: Loading window from configuration file");
@@ -187,11 +217,7 @@ static inline void load_configuration_file_window(nlohmann::json& json, bool ful
     if (json.find("window") == json.end()) {
         spdlog::info("PileAA: No window configuration found using default "
                      "(800,600) 120fps");
-        if (fullscreen) {
-            screen.create(VideoMode::getFullscreenModes()[0], "PileAA", sf::Style::Fullscreen);
-        } else {
-            screen.create(VideoMode(800, 600), "PileAA", sf::Style::Close);
-        }
+        create_screen(VideoMode(800, 600), "PileAA", fullscreen);
         screen.setFramerateLimit(120);
         return;
     }
@@ -201,11 +227,7 @@ static inline void load_configuration_file_window(nlohmann::json& json, bool ful
         const auto& height = window["height"].get<int>();
         const auto& title = window["title"].get<std::string>();
         const auto& fps = window["fps"].get<int>();
-        if (fullscreen) {
-            screen.create(sf::VideoMode::getFullscreenModes()[0], title, sf::Style::Fullscreen);
-        } else {
-            screen.create(VideoMode(width, height), title, sf::Style::Close);
-        }
+        create_screen(VideoMode(width, height), title, fullscreen);
         screen.setFramerateLimit(fps);
         spdlog::info("PileAA: Window created: {} {}x{} at {}fps", title, width,
             height, fps);
@@ -216,6 +238,24 @@ static inline void load_configuration_file_window(nlohmann::json& json, bool ful
     }
 }
 
+static inline void load_configuration_file_ecs(nlohmann::json& json)
+{
+    const unsigned int cores = std::thread::hardware_concurrency();
+    std::size_t workers = cores > 1 ? cores - 1 : 0;
+
+    if (json.find("ecs") != json.end()) {
+        try {
+            workers = json["ecs"]["workers"].get<std::size_t>();
+        } catch (const nlohmann::json::exception& e) {
+            throw App::Error(
+                std::string("ecs: load_configuration_file - Invalid json file: ")
+                + e.what());
+        }
+    }
+    EcsInstance::get().set_workers(workers);
+    spdlog::info("PileAA: ECS systems run on {} worker(s)", workers);
+}
+
 static inline void load_configuration_file(const std::string& filename)
 {
     spdlog::info("PileAA: Loading configuration file: {}", filename);
@@ -229,6 +269,7 @@ static inline void load_configuration_file(const std::string& filename)
         load_configuration_file_resources(App::gameConfig["resources"]);
         load_configuration_file_animations(App::gameConfig["animations"]);
         load_configuration_file_window(App::gameConfig);
+        load_configuration_file_ecs(App::gameConfig);
     } catch (const nlohmann::json::exception& e) {
         throw ResourceManagerError(
             "load_configuration_file - Invalid json file: "
@@ -266,10 +307,12 @@ void setup_paa_system(const std::string& configuration_filename)
 
     load_configuration_file(configuration_filename);
 
+#ifndef PILEAA_HEADLESS
     if (!ImGui::SFML::Init(Screen::get())) {
         throw paa::AABaseError("ImGUI: Initialization failed.");
     }
     spdlog::info("PileAA: ImGui created");
+#endif
 
     GMusicPlayer::get();
     spdlog::info("PileAA: GMusicPlayer created");
@@ -284,6 +327,10 @@ void stop_paa_system()
     InputHandler::destroyInstance();
     spdlog::info("PileAA: InputHandler released");
 
+    // The prefabs point to the textures
+    PrefabRegisterInstance::release();
+    spdlog::info("PileAA: PrefabRegister released");
+
     ResourceManagerInstance::release();
     spdlog::info("PileAA: ResourceManager released");
 
@@ -310,8 +357,10 @@ void stop_paa_system()
     App::release();
     spdlog::info("PileAA: App released");
 
+#ifndef PILEAA_HEADLESS
     ImGui::SFML::Shutdown();
     spdlog::info("PileAA: ImGui released");
+#endif
 
     GMusicPlayer::release();
     spdlog::info("PileAA: GMusicPlayer released");
@@ -25,20 +25,20 @@ static inline void sys_controller_input_manager_system(hl::silva::registry& r)
 
 static inline void sys_sprite_position_updater(hl::silva::registry& r)
 {
-    for (auto&& [_, v, s] : r.view<Position, Sprite>()) {
-        s->setPosition(v.x, v.y);
-    }
+    r.view<Position, Sprite>().parallel_for(
+        [](auto, const Position& v, Sprite& s) { s->setPosition(v.x, v.y); });
 }
 
 static inline void sys_collision_box_sync(hl::silva::registry& r)
 {
-    for (auto&& [_, c, s] : r.view<SCollisionBox, Sprite>()) {
-        const auto r = s->getGlobalBounds();
-        const auto o = s->getOrigin();
+    r.view<SCollisionBox, Sprite>().parallel_for(
+        [](auto, SCollisionBox& c, Sprite& s) {
+            const auto r = s->getGlobalBounds();
+            const auto o = s->getOrigin();
 
-        c->set_position(Vector2i(r.left + o.x, r.top + o.y));
-        c->set_size(Vector2i(r.width, r.height));
-    }
+            c->set_position(Vector2i(r.left + o.x, r.top + o.y));
+            c->set_size(Vector2i(r.width, r.height));
+        });
 }
 
 static inline void sys_collision_check(hl::silva::registry& r)
@@ -59,10 +59,24 @@ void setup_ecs(hl::silva::registry& r)
 {
     r.register_component<Position, Velocity, Sprite, Depth, Health,
          SCollisionBox, InputManagement, Controller, Id>()
-        .add_system(sys_animated_sprite_system)
+        // Runs the callbacks of the inputs, they may touch anything
+        // It runs before the animations (even without workers): entities
+        // spawned by an input are animated and batched in the frame they
+        // are spawned
         .add_system(sys_controller_input_manager_system)
-        .add_system(sys_sprite_position_updater)
-        .add_system(sys_collision_box_sync)
+        // The animation and the position of a sprite live in the same
+        // object, the two sprite systems run one after the other and the
+        // collision boxes wait for both
+        .add_system(sys_animated_sprite_system,
+            hl::silva::reads<Depth>(),
+            hl::silva::writes<Sprite, BatchRenderer>())
+        .add_system(sys_sprite_position_updater,
+            hl::silva::reads<Position>(),
+            hl::silva::writes<Sprite>())
+        .add_system(sys_collision_box_sync,
+            hl::silva::reads<Sprite>(),
+            hl::silva::writes<SCollisionBox>())
+        // Runs the callbacks of the collisions
         .add_system(sys_collision_check);
 }
 
@@ -82,6 +82,14 @@ namespace paa {
     }
 
     Texture FrameBuffer::generateDefaultTexture(const unsigned int& width, const unsigned int& height)
+    {
+        Texture texture;
+
+        texture.loadFromImage(generateDefaultImage(width, height));
+        return texture;
+    }
+
+    Image FrameBuffer::generateDefaultImage(const unsigned int& width, const unsigned int& height)
     {
         FrameBuffer buffer(width, height);
 
@@ -97,11 +105,6 @@ namespace paa {
         buffer.rect(midRight.left, midRight.top, midRight.width, midRight.height, Color::Blue);
         buffer.rect(midBottom.left, midBottom.top, midBottom.width, midBottom.height, Color::Yellow);
 
-        return buffer.toTexture();
-    }
-
-    Image FrameBuffer::generateDefaultImage(const unsigned int& width, const unsigned int& height)
-    {
-        return generateDefaultTexture(width, height).copyToImage();
+        return buffer.toImage();
     }
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "PileAA/Prefab.hpp"
+#include "PileAA/AnimationRegister.hpp"
+
+namespace paa {
+
+Prefab::Prefab(const std::string& textureName, const setup_t& setup)
+    : _sprite(textureName)
+{
+    AnimationRegisterInstance::get().setAnimationToSpriteIfExist(
+        textureName, _sprite);
+    if (setup)
+        setup(_sprite);
+    _sprite.setPosition(0, 0);
+    _bounds = _sprite.getGlobalBounds();
+}
+
+Prefab::setup_t Prefab::animation(const std::string& animationName, bool loop)
+{
+    return [animationName, loop](AnimatedSprite& sprite) {
+        sprite.useAnimation(animationName, loop);
+    };
+}
+
+IntRect Prefab::getBounds(const Position& position) const
+{
+    return IntRect(_bounds.left + position.x, _bounds.top + position.y,
+        _bounds.width, _bounds.height);
+}
+
+Sprite Prefab::makeSprite() const
+{
+    Sprite sprite = make_pooled<AnimatedSprite>(_sprite);
+
+    sprite->restartAnimation();
+    return sprite;
+}
+
+hl::silva::Entity Prefab::instantiate(
+    hl::silva::registry& r, const Position& position) const
+{
+    const hl::silva::Entity e = r.spawn_entity();
+    Sprite sprite = makeSprite();
+
+    sprite->setPosition(position.x, position.y);
+    r.emplace<Position>(e, position)
+        .insert<Sprite>(e, std::move(sprite))
+        .emplace<Depth>(e, 0);
+    for (const auto& init : _components)
+        init(r, e);
+    return e;
+}
+
+Prefab& PrefabRegister::addPrefab(const std::string& name, Prefab prefab)
+{
+    return _prefabs.insert_or_assign(name, std::move(prefab)).first->second;
+}
+
+const Prefab& PrefabRegister::getPrefab(const std::string& name) const
+{
+    auto it = _prefabs.find(name);
+
+    if (it == _prefabs.end())
+        throw Prefab::Error("PileAA::PrefabRegister: Unknown prefab: " + name);
+    return it->second;
+}
+
+bool PrefabRegister::hasPrefab(const std::string& name) const
+{
+    return _prefabs.find(name) != _prefabs.end();
+}
+
+void PrefabRegister::clear() { _prefabs.clear(); }
+
+}
@@ -7,13 +7,54 @@ namespace paa {
 
 void ResourceManager::remove(const std::string& name)
 {
-    auto found = _resourceMap.find(name);
-    if (found == _resourceMap.end())
+    if (!has(name))
         throw ResourceManagerError(
             "ResourceHolder::remove - Resource not found: " + name);
-    _resourceMap.erase(found);
+    _resourceMap.erase(name);
+    _paths.erase(name);
+#ifdef PILEAA_HEADLESS
+    _textureSizes.erase(name);
+#endif
 }
 
-void ResourceManager::clear() { _resourceMap.clear(); }
+void ResourceManager::clear()
+{
+    _resourceMap.clear();
+    _paths.clear();
+#ifdef PILEAA_HEADLESS
+    _textureSizes.clear();
+#endif
+}
+
+bool ResourceManager::has(const std::string& name) const
+{
+    return _resourceMap.find(name) != _resourceMap.end()
+        || _paths.find(name) != _paths.end();
+}
+
+const std::string& ResourceManager::getPath(const std::string& name) const
+{
+    auto found = _paths.find(name);
+    if (found == _paths.end())
+        throw ResourceManagerError(
+            "ResourceHolder::getPath - Resource not found: " + name);
+    return found->second;
+}
+
+Vector2u ResourceManager::getTextureSize(const std::string& name)
+{
+#ifdef PILEAA_HEADLESS
+    auto found = _textureSizes.find(name);
+    if (found == _textureSizes.end()) {
+        spdlog::warn("ResourceHolder::getTextureSize - Texture not found: "
+                     "\"{}\", using default texture",
+            name);
+        return getDefaultImage().getSize();
+    }
+    return found->second;
+#else
+    return get<Texture>(name).getSize();
+#endif
+}
 
 }
\ No newline at end of file
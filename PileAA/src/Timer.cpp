@@ -2,6 +2,44 @@
 
 namespace paa {
 
+// Real time shared by every timer (built on first use, global timers may
+// be built before the statics of this file)
+static const sf::Clock& realClock()
+{
+    static const sf::Clock clock;
+    return clock;
+}
+
+Timer::Timer() { restart(); }
+
+TimeUnit Timer::now() const
+{
+    return _simulated ? _simulationTime
+                      : realClock().getElapsedTime().asMicroseconds() / 1000.0;
+}
+
+sf::Time Timer::getElapsedTime() const
+{
+    return sf::microseconds(static_cast<sf::Int64>((now() - _start) * 1000));
+}
+
+sf::Time Timer::restart()
+{
+    const sf::Time elapsed = getElapsedTime();
+
+    _simulated = _simulating;
+    _start = now();
+    return elapsed;
+}
+
+void Timer::beginSimulation(const TimeUnit& time)
+{
+    _simulating = true;
+    _simulationTime = time;
+}
+
+void Timer::endSimulation() { _simulating = false; }
+
 bool Timer::isFinished() const
 {
     return getElapsedTime().asMilliseconds() >= _targetTime;
@@ -16,6 +54,11 @@ Timer& Timer::setTarget(const TimeUnit& target)
 
 TimeUnit DeltaTimer::getDeltaTime() const { return _deltaTime; }
 
+void DeltaTimer::setDeltaTime(const TimeUnit& deltaTime)
+{
+    _deltaTime = deltaTime;
+}
+
 void DeltaTimer::update()
 {
     sf::Time t = restart();
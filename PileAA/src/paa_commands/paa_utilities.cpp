@@ -18,7 +18,7 @@ paa::AnimatedSprite& internal_paa_set_sprite(
     PAA_ENTITY entity, const std::string& name)
 {
     hl::silva::registry& registry = PAA_ECS;
-    Sprite sprite(new AnimatedSprite(name));
+    Sprite sprite = make_pooled<AnimatedSprite>(name);
     registry.insert<Sprite>(entity, std::move(sprite)).emplace_r<Depth>(0);
     auto& spriteref = registry.get_component<Sprite>(entity);
     PAA_ANIMATION_REGISTER.setAnimationToSpriteIfExist(name, *spriteref);
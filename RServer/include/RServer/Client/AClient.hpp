@@ -1,5 +1,6 @@
 #pragma once
 
+#include "RServer/Client/Inbox.hpp"
 #include "RServer/Server/Server.hpp"
 
 namespace rtype {
@@ -36,6 +37,15 @@ namespace net {
          */
         bool stopped() const;
 
+        /**
+         * @brief Sets the inbox that receives the routed messages
+         *        before they reach the poll queue
+         *        (must be set before the client starts receiving)
+         *
+         * @param inbox The inbox (or nullptr to only use the poll queue)
+         */
+        void set_inbox(inbox* inbox);
+
     private:
         async_queue<shared_message_t> _queue;
 
@@ -47,7 +57,16 @@ namespace net {
          */
         void add_event(shared_message_t message);
 
+        /**
+         * @brief Gives the message at the start of the buffer to the inbox
+         *
+         * @return BufferSizeType The consumed size or 0 if the message is not
+         *         routed and must be parsed as usual
+         */
+        BufferSizeType route_event(const Byte* data, BufferSizeType size);
+
         std::atomic_bool _stopped;
+        inbox* _inbox = nullptr;
     };
 
 }
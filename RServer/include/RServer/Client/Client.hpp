@@ -8,6 +8,7 @@ namespace net {
 
     class UDP_TCP_Client {
     private:
+        inbox _inbox;
         boost::asio::io_context _udp_io_context;
         boost::asio::io_context _tcp_io_context;
         UDPClient _udp_client;
@@ -51,6 +52,12 @@ namespace net {
          */
         TCPClient& tcp();
 
+        /**
+         * @brief Gets the inbox shared by the UDP and the TCP client
+         * @return inbox & The inbox
+         */
+        inbox& get_inbox();
+
         /**
          * @brief Tells whether the server should be restarted
          *        Because a service is down
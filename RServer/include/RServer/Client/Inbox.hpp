@@ -0,0 +1,215 @@
+#pragma once
+
+#include "RServer/Messages/Messages.hpp"
+#include "RServer/ring_buffer.hpp"
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <spdlog/spdlog.h>
+
+namespace rtype {
+namespace net {
+
+    /**
+     * @brief Typed routing of the messages received by a client
+     *
+     *        The io threads decode every routed message directly by value
+     *        into a ring buffer dedicated to its message code (no heap
+     *        allocated message, no dynamic_cast)
+     *        The game thread then calls drain() once per frame: the buffers
+     *        are swapped under a single lock and every message is given to
+     *        the handler registered for its code, in arrival order
+     *
+     *        Messages whose code has no route are not consumed and must be
+     *        handled by the caller (see AClient::poll)
+     */
+    class inbox {
+    public:
+        using sequence_t = uint64_t;
+
+        template <typename Payload> struct update {
+            PlayerID sid = 0;
+            Payload payload;
+        };
+
+        inbox() = default;
+        ~inbox() = default;
+
+        inbox(const inbox&) = delete;
+        inbox& operator=(const inbox&) = delete;
+
+        /**
+         * @brief Routes every message of the given code to the handler
+         *        The message is decoded in a T (T::from is used)
+         *
+         * @param code The code of the message to route
+         * @param handler Called as handler(const T&)
+         */
+        template <typename T, typename Fn> void on(message_code code, Fn&& handler)
+        {
+            set_route(code,
+                std::make_unique<channel<T, message_decoder<T>>>(
+                    std::forward<Fn>(handler)));
+        }
+
+        /**
+         * @brief Routes every UpdateMessage of the given code to the handler
+         *        The content of the update is directly decoded in a Payload
+         *        (a Serializable) without going through an UpdateMessage
+         *
+         * @param code The code of the update message to route
+         * @param handler Called as handler(PlayerID sid, const Payload&)
+         */
+        template <typename Payload, typename Fn>
+        void on_update(message_code code, Fn&& handler)
+        {
+            set_route(code,
+                std::make_unique<
+                    channel<update<Payload>, update_decoder<Payload>>>(
+                    [handler = std::forward<Fn>(handler)](
+                        const update<Payload>& u) {
+                        handler(u.sid, u.payload);
+                    }));
+        }
+
+        /**
+         * @brief Removes the route of the given code (pending messages of
+         *        this code are lost)
+         */
+        void off(message_code code);
+
+        /**
+         * @brief Removes every route (pending messages are lost)
+         *        Must not be called from a handler
+         */
+        void reset();
+
+        /**
+         * @brief Decodes the message at the start of the buffer if its code is
+         *        routed (called from the io threads)
+         *
+         * @param data The buffer starting with a message
+         * @param size The size of the buffer
+         * @return BufferSizeType The size of the consumed message or 0 if the
+         *         message is not routed or invalid
+         */
+        BufferSizeType push(const Byte* data, BufferSizeType size);
+
+        /**
+         * @brief Dispatches every message received since the last drain to
+         *        its handler in arrival order (called from the game thread)
+         *
+         * @return std::size_t The count of dispatched messages
+         */
+        std::size_t drain();
+
+    private:
+        class ichannel {
+        public:
+            virtual ~ichannel() = default;
+
+            // Decodes in the back buffer, returns the consumed size or 0
+            virtual BufferSizeType decode(
+                const Byte* data, BufferSizeType size, sequence_t sequence)
+                = 0;
+
+            // Moves the back buffer to the front buffer
+            virtual void swap() = 0;
+
+            virtual bool pending() const = 0;
+            virtual sequence_t front_sequence() const = 0;
+            virtual void dispatch_front() = 0;
+        };
+
+        template <typename T> struct message_decoder {
+            BufferSizeType operator()(
+                const Byte* data, BufferSizeType size, T& value) const
+            {
+                value.from(data, size);
+                return value.size();
+            }
+        };
+
+        template <typename Payload> struct update_decoder {
+            BufferSizeType operator()(const Byte* data, BufferSizeType size,
+                update<Payload>& value) const
+            {
+                constexpr BufferSizeType header
+                    = sizeof(message_code) + sizeof(PlayerID);
+
+                if (size < header)
+                    throw std::runtime_error("Cannot extract data");
+                value.sid = data[sizeof(message_code)];
+                value.payload.from(data + header, size - header);
+                // An UpdateMessage always extends up to the end of the buffer
+                return size;
+            }
+        };
+
+        template <typename T, typename Decoder> class channel : public ichannel {
+        public:
+            struct entry {
+                sequence_t sequence = 0;
+                T value;
+            };
+
+            template <typename Fn>
+            channel(Fn&& handler)
+                : _handler(std::forward<Fn>(handler))
+            {
+            }
+
+            ~channel() override = default;
+
+            BufferSizeType decode(const Byte* data, BufferSizeType size,
+                sequence_t sequence) override
+            {
+                entry& slot = _back.next();
+                const BufferSizeType consumed
+                    = Decoder()(data, size, slot.value);
+
+                slot.sequence = sequence;
+                _back.commit();
+                return consumed;
+            }
+
+            void swap() override
+            {
+                _front.clear();
+                std::swap(_front, _back);
+            }
+
+            bool pending() const override { return !_front.empty(); }
+
+            sequence_t front_sequence() const override
+            {
+                return _front.front().sequence;
+            }
+
+            void dispatch_front() override
+            {
+                try {
+                    _handler(_front.front().value);
+                } catch (const std::exception& e) {
+                    spdlog::error("inbox: Handler failed: {}", e.what());
+                }
+                _front.pop();
+            }
+
+        private:
+            std::function<void(const T&)> _handler;
+            ring_buffer<entry> _back;
+            ring_buffer<entry> _front;
+        };
+
+        void set_route(message_code code, std::unique_ptr<ichannel> route);
+
+        std::mutex _mutex;
+        std::array<std::unique_ptr<ichannel>, 256> _routes;
+        std::vector<ichannel*> _draining;
+        sequence_t _sequence = 0;
+    };
+
+}
+}
@@ -12,6 +12,11 @@ namespace net {
         boost::asio::ip::udp::endpoint _receiver_endpoint;
         boost::asio::ip::udp::socket _socket;
         boost::asio::ip::udp::endpoint _sender_endpoint;
+        boost::asio::steady_timer _feed_timer;
+
+        clock_sync _clock;
+        reliable_endpoint _feed_reliability;
+        ordered_delivery<std::vector<Byte>> _feed_ordered;
 
         std::atomic_bool _connected;
         TokenType _token;
@@ -68,6 +73,31 @@ namespace net {
          */
         void _add_event(shared_message_t& message);
 
+        /**
+         * @brief Gives a received message to the inbox or the poll queue
+         *
+         * @param data The message
+         * @param size The size of the message
+         */
+        void deliver(const Byte* data, BufferSizeType size);
+
+        /**
+         * @brief Adds the sample of a CLOCK_PONG to the clock
+         */
+        void on_clock_pong(const Byte* data, BufferSizeType size);
+
+        /**
+         * @brief Periodically resends the unacked reliable messages and sends
+         *        the pending acks (runs on the io_context)
+         */
+        void schedule_feed_update();
+
+        /**
+         * @brief Sends a message with its feed header
+         */
+        void send_packet(
+            const feed_header& header, const Byte* data, BufferSizeType size);
+
     public:
         /**
          * @brief Send a message to the server asynchronously
@@ -80,9 +110,24 @@ namespace net {
 
         /**
          * @brief Send a message to the server asynchronously
+         *        Its delivery on the feed depends on its code
+         *        (see delivery_of)
          * @param message The message to send
+         * @return feed_header The header the message was sent with
+         */
+        feed_header send(const IMessage& message);
+
+        /**
+         * @brief Gets the reliability state of the feed channel
+         *        (tells which packets the server acked)
+         */
+        const reliable_endpoint& feed_reliability() const;
+
+        /**
+         * @brief Gets the estimated clock of the server, synchronized by
+         *        the pings sent on the feed (gives the shared tick)
          */
-        void send(const IMessage& message);
+        const clock_sync& clock() const;
 
         /**
          * @brief Request connection init from feed
@@ -104,7 +149,7 @@ namespace net {
 
     private:
         boost::shared_ptr<udp_buffer_t> _buf_recv;
-        ClientID _id;
+        ClientID _id = static_cast<ClientID>(-1);
     };
 }
 }
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "RServer/Messages/Messages.hpp"
+
+#include <array>
+#include <chrono>
+#include <mutex>
+
+namespace rtype {
+namespace net {
+
+// Ticks per second of the shared tick
+#ifndef RTYPE_TICK_RATE
+#define RTYPE_TICK_RATE 60
+#endif
+
+// Interval between two pings once the clock is synchronized
+#ifndef RTYPE_CLOCK_PING_MS
+#define RTYPE_CLOCK_PING_MS 1000
+#endif
+
+// Interval between two pings until the filter is full
+#ifndef RTYPE_CLOCK_FAST_PING_MS
+#define RTYPE_CLOCK_FAST_PING_MS 100
+#endif
+
+// Count of samples the offset is chosen from
+#ifndef RTYPE_CLOCK_SAMPLES
+#define RTYPE_CLOCK_SAMPLES 8
+#endif
+
+    using clock_time_t = int64_t; // Microseconds
+    using feed_tick_t = uint32_t;
+
+    /**
+     * @brief Sent by a client (CLOCK_PING), origin is its local time
+     *
+     *        Layout: origin (varint)
+     */
+    struct clock_ping : public Serializable {
+        clock_time_t origin = 0;
+
+        clock_ping() = default;
+
+        std::vector<Byte> serialize() const override;
+        void from(const Byte* data, const BufferSizeType size) override;
+    };
+
+    /**
+     * @brief Reply of the server to a ping (CLOCK_PONG), receive and
+     *        transmit are the server times the ping arrived and the reply left
+     *
+     *        Layout: origin, receive then transmit (varints)
+     */
+    struct clock_pong : public Serializable {
+        clock_time_t origin = 0;
+        clock_time_t receive = 0;
+        clock_time_t transmit = 0;
+
+        clock_pong() = default;
+
+        std::vector<Byte> serialize() const override;
+        void from(const Byte* data, const BufferSizeType size) override;
+    };
+
+    /**
+     * @brief Estimates the clock of the server from ping exchanges
+     *        (NTP like, the offset of the sample with the lowest round trip
+     *        time among the last ones is used) and gives the shared tick
+     *
+     *        The clock of the server starts when its clock_sync is created,
+     *        its offset is always 0
+     *        It is thread safe
+     */
+    class clock_sync {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        clock_sync();
+        ~clock_sync() = default;
+
+        /**
+         * @brief The local time since the creation of this clock
+         */
+        clock_time_t time(clock::time_point point = clock::now()) const;
+
+        /**
+         * @brief The estimated time of the server
+         */
+        clock_time_t server_time(clock::time_point point = clock::now()) const;
+
+        /**
+         * @brief The estimated tick of the server, it never goes back even
+         *        if the offset is corrected
+         */
+        feed_tick_t tick(clock::time_point point = clock::now()) const;
+
+        /**
+         * @brief Tells whether a ping should be sent now, the next one is
+         *        then expected after the ping interval
+         */
+        bool should_ping(clock::time_point point = clock::now());
+
+        clock_ping ping(clock::time_point point = clock::now()) const;
+
+        /**
+         * @brief Builds the reply to a ping (server side)
+         *
+         * @param ping The received ping
+         * @param received When the ping arrived
+         */
+        clock_pong pong(const clock_ping& ping, clock::time_point received) const;
+
+        /**
+         * @brief Adds the sample of a reply (client side)
+         *
+         * @param pong The received reply
+         * @param received When the reply arrived
+         */
+        void on_pong(const clock_pong& pong, clock::time_point received = clock::now());
+
+        /**
+         * @brief The estimated offset of the server clock (server - local)
+         */
+        clock_time_t offset() const;
+
+        /**
+         * @brief The smoothed round trip time
+         */
+        clock_time_t rtt() const;
+
+        /**
+         * @brief Tells whether a reply was received yet
+         */
+        bool synchronized() const;
+
+    private:
+        struct sample {
+            clock_time_t offset = 0;
+            clock_time_t rtt = 0;
+        };
+
+        static constexpr clock_time_t TICK_DURATION = 1000000 / RTYPE_TICK_RATE;
+
+        const clock::time_point _epoch;
+
+        mutable std::mutex _mutex;
+        std::array<sample, RTYPE_CLOCK_SAMPLES> _samples;
+        std::size_t _count = 0;
+        std::size_t _next = 0;
+        clock_time_t _offset = 0;
+        clock_time_t _rtt = 0;
+        mutable feed_tick_t _last_tick = 0;
+        clock::time_point _next_ping;
+    };
+
+}
+}
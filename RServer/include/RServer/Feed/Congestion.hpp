@@ -0,0 +1,129 @@
+#pragma once
+
+#include "RServer/Feed/Sequence.hpp"
+
+#include <array>
+#include <chrono>
+
+namespace rtype {
+namespace net {
+
+// Bandwidth (in bytes per second) a feed connection should stay under
+#ifndef RTYPE_FEED_TARGET_BANDWIDTH
+#define RTYPE_FEED_TARGET_BANDWIDTH 16384
+#endif
+
+// Part of the packets that may be lost before the send rate is lowered
+#ifndef RTYPE_FEED_TARGET_LOSS
+#define RTYPE_FEED_TARGET_LOSS 0.05
+#endif
+
+// Bounds of the interval between two state updates
+#ifndef RTYPE_FEED_MIN_INTERVAL_MS
+#define RTYPE_FEED_MIN_INTERVAL_MS 16
+#endif
+
+#ifndef RTYPE_FEED_MAX_INTERVAL_MS
+#define RTYPE_FEED_MAX_INTERVAL_MS 250
+#endif
+
+    /**
+     * @brief What is known about a feed connection
+     */
+    struct link_stats {
+        double rtt = 0; // Smoothed round trip time (in seconds)
+        double loss = 0; // Part of the packets that were not acked
+        double bandwidth = 0; // Bytes sent per second
+        std::chrono::milliseconds interval { RTYPE_FEED_MIN_INTERVAL_MS };
+    };
+
+    /**
+     * @brief Estimates the round trip time, the loss and the bandwidth of a
+     *        connection from the packets sent and the acks of the peer
+     *        Ack only packets must not be given, the peer never acks them
+     *        (not thread safe)
+     */
+    class link_estimator {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        link_estimator() = default;
+        ~link_estimator() = default;
+
+        void on_sent(feed_sequence_t sequence, std::size_t bytes,
+            clock::time_point now);
+
+        /**
+         * @brief Counts the bytes of a packet that is not tracked
+         *        (an ack only packet)
+         */
+        void on_untracked(std::size_t bytes);
+
+        void on_acked(feed_sequence_t sequence, clock::time_point now);
+
+        /**
+         * @brief Counts as lost the packets the peer can no longer ack
+         *        (older than its ack window or unacked for too long)
+         *
+         * @param ack The most recent ack of the peer
+         */
+        void expire(feed_sequence_t ack, clock::time_point now);
+
+        double rtt() const { return _rtt; }
+        double loss() const { return _loss; }
+        double bandwidth() const { return _bandwidth; }
+
+    private:
+        struct sent_packet {
+            bool valid = false;
+            feed_sequence_t sequence = 0;
+            clock::time_point time;
+        };
+
+        void resolve(sent_packet& packet, bool lost);
+
+        static constexpr std::size_t WINDOW = 64;
+
+        std::array<sent_packet, WINDOW> _sent;
+        double _rtt = 0.1;
+        bool _rtt_any = false;
+        double _loss = 0;
+        double _bandwidth = 0;
+        std::size_t _bytes = 0;
+        clock::time_point _bytes_since = clock::now();
+    };
+
+    /**
+     * @brief Chooses the interval between two state updates of a
+     *        connection: it is doubled when the connection loses too much or
+     *        goes over its bandwidth and shortened slowly while it does not
+     *        (additive increase, multiplicative decrease of the rate)
+     *        (not thread safe)
+     */
+    class rate_controller {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        rate_controller() = default;
+        ~rate_controller() = default;
+
+        /**
+         * @brief Adapts the interval, at most once per round trip
+         */
+        void update(const link_estimator& link, clock::time_point now);
+
+        std::chrono::milliseconds interval() const
+        {
+            return std::chrono::milliseconds(static_cast<int64_t>(_interval));
+        }
+
+    private:
+        // Milliseconds removed from the interval per round trip
+        static constexpr double STEP = 2;
+
+        double _interval = RTYPE_FEED_MIN_INTERVAL_MS;
+        clock::time_point _last = clock::now();
+    };
+
+}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "RServer/Feed/Clock.hpp"
+#include "RServer/Feed/Snapshot.hpp"
+
+#include <deque>
+
+namespace rtype {
+namespace net {
+
+// Count of input frames carried by each UPDATE_PLAYER (the latest included)
+#ifndef RTYPE_INPUT_HISTORY
+#define RTYPE_INPUT_HISTORY 4
+#endif
+
+// Count of bits of an input frame (move and shoot bits)
+#ifndef RTYPE_INPUT_BITS
+#define RTYPE_INPUT_BITS 5
+#endif
+
+    using input_bits_t = uint8_t;
+
+    /**
+     * @brief The input of a player from a tick until the next frame
+     */
+    struct input_frame {
+        feed_tick_t tick = 0;
+        input_bits_t bits = 0;
+    };
+
+    /**
+     * @brief Snapshot of a player followed by its last input frames, to be
+     *        carried by an UpdateMessage (UPDATE_PLAYER)
+     *        A receiver that lost some packets finds the inputs it missed in
+     *        the next one, without waiting for a resend
+     *
+     *        Layout: size of the snapshot (varint), the snapshot, count of
+     *        frames (3 bits), then for each frame from the newest its tick
+     *        (varint, then the distance to the previous one) and its bits
+     */
+    struct player_update : public Serializable {
+        snapshot_payload snapshot;
+        std::vector<input_frame> inputs; // Newest first
+
+        player_update() = default;
+
+        player_update(snapshot_payload&& snapshot,
+            const std::deque<input_frame>& inputs)
+            : snapshot(std::move(snapshot))
+            , inputs(inputs.begin(), inputs.end())
+        {
+        }
+
+        std::vector<Byte> serialize() const override;
+        void from(const Byte* data, const BufferSizeType size) override;
+    };
+
+    /**
+     * @brief The last input frames of a player (sender side)
+     *        A frame is only added when the input changes
+     */
+    class input_history {
+    public:
+        input_history() = default;
+        ~input_history() = default;
+
+        /**
+         * @brief Records the input of a tick
+         *        Two frames never share a tick, a change in the same tick as
+         *        the previous one is put on the next tick
+         *
+         * @return bool true if the input changed
+         */
+        bool push(feed_tick_t tick, input_bits_t bits);
+
+        /**
+         * @brief The frames, newest first
+         */
+        const std::deque<input_frame>& frames() const { return _frames; }
+
+        void reset() { _frames.clear(); }
+
+    private:
+        std::deque<input_frame> _frames;
+    };
+
+    /**
+     * @brief Keeps track of the input frames already received from a player
+     *        (receiver side)
+     */
+    class input_receiver {
+    public:
+        input_receiver() = default;
+        ~input_receiver() = default;
+
+        /**
+         * @brief Gets the frames of a received history that were not
+         *        received before, oldest first
+         *        Every frame but the newest one was missed (its packet was
+         *        lost or is late)
+         *
+         * @param frames The received frames, newest first
+         */
+        std::vector<input_frame> receive(const std::vector<input_frame>& frames);
+
+        void reset() { _any = false; }
+
+    private:
+        bool _any = false;
+        feed_tick_t _last = 0;
+    };
+
+}
+}
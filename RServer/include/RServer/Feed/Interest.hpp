@@ -0,0 +1,136 @@
+#pragma once
+
+#include "RServer/Feed/Congestion.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace rtype {
+namespace net {
+
+// Distance (in pixels) around the view of a recipient whose entities are
+// still replicated to it (about to enter the screen)
+#ifndef RTYPE_INTEREST_MARGIN
+#define RTYPE_INTEREST_MARGIN 64
+#endif
+
+// Distance (in pixels) to the focus of a recipient at which the priority of
+// an entity is halved
+#ifndef RTYPE_INTEREST_RANGE
+#define RTYPE_INTEREST_RANGE 192
+#endif
+
+// Relevance of an update that carries an event (a shot, a hit) compared to
+// one that only moves its entity
+#ifndef RTYPE_INTEREST_EVENT_RELEVANCE
+#define RTYPE_INTEREST_EVENT_RELEVANCE 4
+#endif
+
+// Bytes per second of state updates a recipient may get
+#ifndef RTYPE_INTEREST_BANDWIDTH
+#define RTYPE_INTEREST_BANDWIDTH RTYPE_FEED_TARGET_BANDWIDTH
+#endif
+
+    using interest_id_t = uint16_t;
+
+    struct interest_point {
+        double x = 0;
+        double y = 0;
+    };
+
+    /**
+     * @brief What a recipient sees: the scroll window, and the entity it
+     *        plays if any (the closest entities matter the most)
+     */
+    struct interest_view {
+        interest_point origin;
+        interest_point size;
+        std::optional<interest_point> focus;
+
+        /**
+         * @brief Tells whether a position is in the view or close enough
+         *        to it (see RTYPE_INTEREST_MARGIN)
+         */
+        bool contains(const interest_point& pos) const;
+    };
+
+    /**
+     * @brief An entity that has an update waiting for a recipient
+     */
+    struct interest_candidate {
+        interest_id_t id = 0;
+        interest_point pos;
+        double relevance = 1; // Higher for the updates that carry an event
+    };
+
+    /**
+     * @brief Chooses which entity updates a recipient gets (one per
+     *        recipient, not thread safe)
+     *
+     *        Each entity has a priority accumulator: every time it has an
+     *        update waiting, its priority for the recipient is added to it,
+     *        and it is reset once the update is sent. The updates go out by
+     *        accumulated priority while the budget of the recipient lasts,
+     *        an entity left behind gains priority until it is sent
+     *        The budget is refilled at RTYPE_INTEREST_BANDWIDTH and may hold
+     *        up to RTYPE_FEED_MAX_INTERVAL_MS of it
+     */
+    class interest_manager {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        interest_manager() = default;
+        ~interest_manager() = default;
+
+        /**
+         * @brief Priority of an entity for a recipient
+         *        0 outside of its view, otherwise the relevance of the
+         *        update lowered with the distance to the focus of the view
+         */
+        static double priority(
+            const interest_view& view, const interest_candidate& candidate);
+
+        /**
+         * @brief Accumulates the priority of the candidates and orders them
+         *
+         * @return The ids of the candidates in the view, highest accumulated
+         *         priority first
+         */
+        std::vector<interest_id_t> rank(const interest_view& view,
+            const std::vector<interest_candidate>& candidates);
+
+        /**
+         * @brief Records that the update of an entity was sent
+         *
+         * @param id The entity
+         * @param bytes The size of the packet that carried it
+         */
+        void sent(interest_id_t id, std::size_t bytes);
+
+        /**
+         * @brief Adds to the budget the bytes allowed since the last refill
+         */
+        void refill(clock::time_point now = clock::now());
+
+        /**
+         * @brief Tells whether another update may be sent
+         *        (the last one may go over the budget, it is paid back on
+         *        the next refills)
+         */
+        bool has_budget() const { return _budget > 0; }
+
+        void forget(interest_id_t id) { _accumulators.erase(id); }
+
+        void reset();
+
+    private:
+        std::unordered_map<interest_id_t, double> _accumulators;
+        double _budget = 0;
+        clock::time_point _refilled = clock::now();
+    };
+
+}
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "RServer/Feed/Clock.hpp"
+#include "RServer/Messages/BitStream.hpp"
+#include "RServer/Messages/Messages.hpp"
+
+#include <array>
+#include <functional>
+#include <map>
+
+namespace rtype {
+namespace net {
+
+// Ticks simulated per second by a lockstep session
+#ifndef RTYPE_LOCKSTEP_TICK_RATE
+#define RTYPE_LOCKSTEP_TICK_RATE RTYPE_TICK_RATE
+#endif
+
+// Most ticks simulated past the last confirmed one, the session waits for
+// the late inputs once it is reached
+#ifndef RTYPE_LOCKSTEP_MAX_ROLLBACK
+#define RTYPE_LOCKSTEP_MAX_ROLLBACK 30
+#endif
+
+    using lockstep_tick_t = uint32_t;
+    using lockstep_input_t = uint8_t;
+
+    /**
+     * @brief Inputs of one player for consecutive ticks, to be carried by an
+     *        UpdateMessage (LOCKSTEP_INPUT)
+     *
+     *        Layout: tick of the first input (varint), count of inputs
+     *        (varint) then each input (8 bits)
+     */
+    struct lockstep_input : public Serializable {
+        lockstep_tick_t tick = 0;
+        std::vector<lockstep_input_t> inputs;
+
+        lockstep_input() = default;
+
+        std::vector<Byte> serialize() const override;
+        void from(const Byte* data, const BufferSizeType size) override;
+    };
+
+    /**
+     * @brief Deterministic lockstep simulation of a room with rollback
+     *
+     *        Only the inputs of the players are exchanged, every peer runs
+     *        the whole simulation at a fixed timestep
+     *        The local input sampled at tick t is used at tick t + delay, a
+     *        missing remote input is predicted by repeating the previous
+     *        one. A tick is confirmed once every input of it is known and
+     *        matches what was simulated. When a late input differs from
+     *        its prediction the state of the last confirmed tick is loaded
+     *        and the ticks that followed are simulated again
+     *
+     *        Without a load callback nothing is predicted: a tick is only
+     *        simulated once every input of it is known (the state must be
+     *        fully restorable for a rollback, see registry::save)
+     *        (not thread safe)
+     */
+    class lockstep_session {
+    public:
+        using inputs_t = std::array<lockstep_input_t, RTYPE_PLAYER_COUNT>;
+
+        struct callbacks {
+            // Samples the input of the local player
+            std::function<lockstep_input_t()> input;
+            // Simulates the given tick with the inputs of every player
+            std::function<void(lockstep_tick_t, const inputs_t&)> step;
+            // Saves the state of the simulation after the given tick
+            // (every simulated tick, a state older than the confirmed tick
+            // is not loaded anymore)
+            std::function<void(lockstep_tick_t)> save;
+            // Loads the state saved after the given tick, nullptr disables
+            // the prediction and the rollbacks
+            std::function<void(lockstep_tick_t)> load;
+            // The given tick is confirmed, it is never simulated again
+            // (without rollbacks it is the tick that was just simulated)
+            std::function<void(lockstep_tick_t)> confirm;
+            // Sends the local inputs to the other players
+            std::function<void(const lockstep_input&)> send;
+        };
+
+        /**
+         * @brief Creates a session, with rollbacks the current state is
+         *        saved as tick 0
+         *
+         * @param local The id of the local player
+         * @param players The players that take part in the session
+         * @param input_delay The count of ticks between the sampling of a
+         *        local input and its use
+         * @param cb The callbacks of the simulation
+         * @param timestep The duration of a tick (in seconds)
+         */
+        lockstep_session(PlayerID local,
+            const std::array<Bool, RTYPE_PLAYER_COUNT>& players,
+            std::size_t input_delay, callbacks cb,
+            double timestep = 1.0 / RTYPE_LOCKSTEP_TICK_RATE);
+        ~lockstep_session() = default;
+
+        /**
+         * @brief Rolls back if a late input was mispredicted, then simulates
+         *        the ticks that fit in the elapsed time
+         *
+         * @param dt The time elapsed since the last update (in seconds)
+         */
+        void update(double dt);
+
+        /**
+         * @brief Records the inputs received from a player
+         */
+        void receive(PlayerID player, const lockstep_input& message);
+
+        /**
+         * @brief Stops waiting for the inputs of a player that left
+         *        (its input is 0 from now on)
+         */
+        void remove_player(PlayerID player);
+
+        lockstep_tick_t tick() const { return _simulated; }
+        lockstep_tick_t confirmed() const { return _confirmed; }
+        double timestep() const { return _timestep; }
+
+        /**
+         * @brief Count of rollbacks since the start of the session
+         */
+        std::size_t rollbacks() const { return _rollbacks; }
+
+    private:
+        struct frame {
+            inputs_t inputs = { 0 };
+            uint8_t known = 0; // Bit n is set once the input of player n is known
+            inputs_t used = { 0 }; // Inputs (or predictions) simulated
+            bool simulated = false;
+        };
+
+        bool complete(const frame& f) const;
+        bool predicted(const frame& f) const;
+        bool predicts() const;
+        void simulate();
+        void confirm();
+        void rollback();
+
+        const PlayerID _local;
+        const std::size_t _delay;
+        const double _timestep;
+        callbacks _callbacks;
+
+        uint8_t _players = 0;
+        std::map<lockstep_tick_t, frame> _frames;
+        lockstep_tick_t _simulated = 0;
+        lockstep_tick_t _confirmed = 0;
+        inputs_t _confirmed_inputs = { 0 };
+        inputs_t _previous = { 0 };
+        double _accumulator = 0;
+        bool _rollback = false;
+        std::size_t _rollbacks = 0;
+        lockstep_input _outgoing;
+    };
+
+}
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "RServer/Feed/Clock.hpp"
+#include "RServer/Feed/Congestion.hpp"
+#include "RServer/Feed/Sequence.hpp"
+#include "RServer/Messages/Messages.hpp"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace rtype {
+namespace net {
+
+#ifndef RTYPE_FEED_RESEND_MS
+#define RTYPE_FEED_RESEND_MS 100
+#endif
+
+#ifndef RTYPE_FEED_ACK_DELAY_MS
+#define RTYPE_FEED_ACK_DELAY_MS 30
+#endif
+
+#ifndef RTYPE_FEED_UPDATE_MS
+#define RTYPE_FEED_UPDATE_MS 20
+#endif
+
+// Sends of a reliable message without an ack after which the peer is
+// considered disconnected (see reliable_endpoint::lost)
+#ifndef RTYPE_FEED_MAX_RESEND
+#define RTYPE_FEED_MAX_RESEND 50
+#endif
+
+// Count of reliable unordered messages before the most recent one whose
+// duplicates are detected, it must exceed the count of such messages sent
+// while one is resent RTYPE_FEED_MAX_RESEND times
+#ifndef RTYPE_FEED_UNORDERED_WINDOW
+#define RTYPE_FEED_UNORDERED_WINDOW 1024
+#endif
+
+    /**
+     * @brief How a message sent on the feed channel is delivered
+     *
+     *        unreliable_sequenced: may be lost, older messages are dropped
+     *        (per stream: the message code and the player id of an
+     *        UpdateMessage, see reliable_endpoint::receive)
+     *        reliable_unordered: resent until acked, delivered once as soon as
+     *        received
+     *        reliable_ordered: resent until acked, delivered once in the
+     *        order it was sent
+     *        ack_only: carries no message, only the acks of the header
+     *        unreliable_unordered: may be lost, delivered as soon as received
+     *        even after a more recent one (the receiver orders it, see
+     *        snapshot_decoder)
+     */
+    enum class delivery : Byte {
+        unreliable_sequenced = 0,
+        reliable_unordered,
+        reliable_ordered,
+        ack_only,
+        unreliable_unordered,
+        count
+    };
+
+    /**
+     * @brief Gives the delivery used for each message code on the feed
+     */
+    delivery delivery_of(message_code code);
+
+    /**
+     * @brief Header put in front of every message sent on the feed
+     *
+     *        sequence: sequence of the packet (one per packet sent)
+     *        ack: most recent packet sequence received from the peer
+     *        ack_bits: bit n tells whether (ack - n - 1) was received
+     *        mode: the delivery of the message
+     *        channel_sequence: sequence of the message in its delivery channel
+     *        (kept between resends)
+     *        tick: shared tick of the sender when the packet left
+     *        (see clock_sync)
+     */
+    struct feed_header {
+        feed_sequence_t sequence = 0;
+        feed_sequence_t ack = 0;
+        uint32_t ack_bits = 0;
+        delivery mode = delivery::unreliable_sequenced;
+        feed_sequence_t channel_sequence = 0;
+        feed_tick_t tick = 0;
+
+        static constexpr BufferSizeType SIZE = sizeof(feed_sequence_t) * 3
+            + sizeof(uint32_t) + sizeof(delivery) + sizeof(feed_tick_t);
+
+        void write(Serializer& s) const;
+        void from(const Byte* data, const BufferSizeType size);
+    };
+
+    /**
+     * @brief Reliability state of one side of a feed channel
+     *        (sequence numbers, acks, resends and duplicate detection)
+     *        It is thread safe
+     */
+    class reliable_endpoint {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        enum class verdict {
+            deliver, // Deliver the message now
+            ordered, // Give the message to an ordered_delivery
+            drop // Duplicate, outdated or ack only
+        };
+
+        struct packet {
+            feed_header header;
+            std::vector<Byte> payload;
+        };
+
+        reliable_endpoint() = default;
+        ~reliable_endpoint() = default;
+
+        /**
+         * @brief Prepares the header of a message that is going to be sent
+         *        Reliable messages are kept until they are acked
+         *
+         * @param mode The delivery of the message
+         * @param data The serialized message
+         * @param size The size of the message
+         * @return feed_header The header to put in front of the message
+         */
+        feed_header send(delivery mode, const Byte* data, BufferSizeType size);
+
+        /**
+         * @brief Same as above but the delivery depends on the message code
+         */
+        feed_header send(const Byte* data, BufferSizeType size);
+
+        /**
+         * @brief Processes the header of a received packet
+         *        Every new packet is acked, even when its message is dropped:
+         *        an unacked packet is counted as lost (see link_estimator)
+         *        A sequenced message older than the last one of its stream
+         *        (its first two bytes: the code and the player id of an
+         *        UpdateMessage) is dropped
+         *
+         * @param header The received header
+         * @param data The message that follows the header
+         * @param size The size of the message
+         * @return verdict What to do with the message
+         */
+        verdict receive(
+            const feed_header& header, const Byte* data, BufferSizeType size);
+
+        /**
+         * @brief Gets the packets that must be sent now:
+         *        the unacked reliable messages that timed out and an ack only
+         *        packet if the peer waits for acks and nothing was sent lately
+         *
+         * @param packets Filled with the packets to send
+         */
+        void update(std::vector<packet>& packets);
+
+        /**
+         * @brief Count of reliable messages that are not acked yet
+         */
+        std::size_t pending() const;
+
+        /**
+         * @brief Tells whether a reliable message was sent
+         *        RTYPE_FEED_MAX_RESEND times without being acked: the peer is
+         *        gone and the connection must be closed
+         *        (No message is dropped, the peer cannot skip an ordered
+         *        one, but nothing is resent anymore)
+         */
+        bool lost() const;
+
+        /**
+         * @brief Tells whether the peer acked the packet of the given sequence
+         *        Only the 33 packets before the last ack of the peer are known,
+         *        an older packet is considered as not acked
+         *
+         * @param sequence The sequence of the packet (see feed_header)
+         */
+        bool acked(feed_sequence_t sequence) const;
+
+        /**
+         * @brief Sets the clock the headers are stamped with, it must outlive
+         *        the endpoint (nullptr stamps 0)
+         */
+        void set_clock(const clock_sync* clock);
+
+        /**
+         * @brief The most recent tick received from the peer
+         */
+        feed_tick_t remote_tick() const;
+
+        /**
+         * @brief The estimated round trip time, loss and bandwidth of the
+         *        connection, with the interval chosen from them
+         */
+        link_stats stats() const;
+
+        /**
+         * @brief The interval the state updates (unreliable messages sent
+         *        periodically) should keep on this connection, it grows when
+         *        the connection is congested
+         */
+        std::chrono::milliseconds send_interval() const;
+
+    private:
+        struct pending_message {
+            delivery mode;
+            feed_sequence_t channel_sequence;
+            std::vector<Byte> payload;
+            std::vector<feed_sequence_t> sequences;
+            clock::time_point last_sent;
+        };
+
+        feed_header next_header(delivery mode);
+        void on_acked(feed_sequence_t sequence);
+        void process_acks(const feed_header& header);
+        bool track_remote_sequence(feed_sequence_t sequence);
+
+        mutable std::mutex _mutex;
+
+        const clock_sync* _clock = nullptr;
+        feed_tick_t _remote_tick = 0;
+
+        link_estimator _link;
+        rate_controller _rate;
+
+        // Starts at 1 so the ack 0 sent by a peer that did not receive
+        // anything yet cannot ack our first packet
+        feed_sequence_t _local_sequence = 1;
+        std::array<feed_sequence_t, static_cast<std::size_t>(delivery::count)>
+            _channel_sequences = { 0 };
+        std::deque<pending_message> _pending;
+
+        // Most recent ack field received from the peer
+        bool _remote_ack_any = false;
+        feed_sequence_t _remote_ack = 0;
+        uint32_t _remote_ack_bits = 0;
+
+        bool _received_any = false;
+        feed_sequence_t _remote_sequence = 0;
+        uint32_t _received_bits = 0;
+
+        bool _ack_pending = false;
+        clock::time_point _last_sent = clock::now();
+        bool _lost = false;
+
+        // Sequenced channel, last sequence received in each stream
+        std::map<uint16_t, feed_sequence_t> _last_sequenced;
+
+        // Duplicate detection of the reliable unordered channel
+        // (bit n tells whether (_last_unordered - n) was received, an older
+        // message is dropped)
+        bool _unordered_any = false;
+        feed_sequence_t _last_unordered = 0;
+        std::bitset<RTYPE_FEED_UNORDERED_WINDOW> _unordered_received;
+
+        bool track_unordered_sequence(feed_sequence_t sequence);
+    };
+
+    /**
+     * @brief Reorders the messages of the reliable ordered channel
+     *        Messages are released only once every previous one was released
+     *        (not thread safe)
+     */
+    template <typename T> class ordered_delivery {
+    public:
+        ordered_delivery() = default;
+        ~ordered_delivery() = default;
+
+        /**
+         * @brief Pushes a received message and appends to ready every
+         *        message that can now be delivered (in order)
+         *
+         * @param channel_sequence The channel sequence of the message
+         * @param value The message
+         * @param ready The messages to deliver
+         */
+        void push(feed_sequence_t channel_sequence, T value, std::vector<T>& ready)
+        {
+            if (channel_sequence != _expected
+                && !sequence_greater_than(channel_sequence, _expected))
+                return; // Already delivered
+            _held.emplace(static_cast<feed_sequence_t>(channel_sequence - _expected),
+                std::move(value));
+            while (!_held.empty() && _held.begin()->first == 0) {
+                ready.push_back(std::move(_held.begin()->second));
+                _held.erase(_held.begin());
+                rebase();
+            }
+        }
+
+        /**
+         * @brief Count of messages waiting for an older one
+         */
+        std::size_t held() const { return _held.size(); }
+
+    private:
+        // Keys are kept relative to _expected so the map stays sorted
+        // across the wrap around of the sequences
+        void rebase()
+        {
+            std::map<feed_sequence_t, T> held;
+
+            ++_expected;
+            for (auto& it : _held)
+                held.emplace(static_cast<feed_sequence_t>(it.first - 1),
+                    std::move(it.second));
+            _held = std::move(held);
+        }
+
+        feed_sequence_t _expected = 0;
+        std::map<feed_sequence_t, T> _held;
+    };
+
+}
+}
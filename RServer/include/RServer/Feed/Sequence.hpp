@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace rtype {
+namespace net {
+
+    using feed_sequence_t = uint16_t;
+
+    /**
+     * @brief Tells whether the sequence a is more recent than b
+     *        (handles the wrap around of the sequence numbers)
+     */
+    static inline bool sequence_greater_than(feed_sequence_t a, feed_sequence_t b)
+    {
+        constexpr feed_sequence_t half = 1 << (sizeof(feed_sequence_t) * 8 - 1);
+
+        return ((a > b) && (a - b <= half)) || ((a < b) && (b - a > half));
+    }
+
+}
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include "RServer/Feed/Reliability.hpp"
+#include "RServer/Messages/BitStream.hpp"
+
+#include <array>
+#include <optional>
+
+namespace rtype {
+namespace net {
+
+// Count of snapshots remembered by each side, a baseline older than that is
+// forgotten and the full state is sent instead (must be lower than 256)
+#ifndef RTYPE_SNAPSHOT_HISTORY
+#define RTYPE_SNAPSHOT_HISTORY 32
+#endif
+
+// A full state is sent at least once every RTYPE_SNAPSHOT_KEYFRAME snapshots
+// so a receiver that lost its history catches up
+#ifndef RTYPE_SNAPSHOT_KEYFRAME
+#define RTYPE_SNAPSHOT_KEYFRAME 64
+#endif
+
+    using snapshot_id_t = uint8_t;
+
+    /**
+     * @brief An encoded snapshot, to be carried by an UpdateMessage
+     */
+    struct snapshot_payload : public Serializable {
+        std::vector<Byte> bytes;
+
+        snapshot_payload() = default;
+
+        snapshot_payload(std::vector<Byte>&& bytes)
+            : bytes(std::move(bytes))
+        {
+        }
+
+        std::vector<Byte> serialize() const override { return bytes; }
+
+        void from(const Byte* data, const BufferSizeType size) override
+        {
+            bytes.assign(data, data + size);
+        }
+    };
+
+    namespace snapshot {
+
+        static constexpr bits::ranged ID { 0, 0xFF };
+        static constexpr bits::ranged BASELINE_DISTANCE { 1, RTYPE_SNAPSHOT_HISTORY - 1 };
+
+        // The state as the receiver will decode it (after quantization)
+        template <typename State> State quantize(const State& state)
+        {
+            const std::vector<Byte> bytes = State::schema().serialize(state);
+            State q;
+
+            State::schema().from(bytes.data(), bytes.size(), q);
+            return q;
+        }
+
+    }
+
+    /**
+     * @brief Encodes the successive states of one element for one recipient
+     *        Only the fields that changed since the most recent snapshot
+     *        acked by the recipient are written
+     *
+     *        Layout: id (8 bits), has baseline (1 bit) then either the
+     *        distance to the baseline (5 bits) and State::schema().write_delta
+     *        or the full State::schema().write
+     *
+     *        State must be default constructible and provide a static
+     *        schema() returning a bits::schema (not thread safe)
+     */
+    template <typename State> class snapshot_encoder {
+    public:
+        snapshot_encoder() = default;
+        ~snapshot_encoder() = default;
+
+        /**
+         * @brief Encodes the state against the most recent acked snapshot
+         *        sent() must then be called with the packet that carries it
+         *
+         * @param state The state to encode
+         * @param endpoint The reliability of the feed the state is sent on
+         * @return snapshot_payload The encoded snapshot
+         */
+        snapshot_payload encode(const State& state, const reliable_endpoint& endpoint)
+        {
+            const entry* baseline = refresh(endpoint);
+            const snapshot_id_t id = _next++;
+            bit_writer w;
+
+            if (_since_keyframe + 1 >= RTYPE_SNAPSHOT_KEYFRAME)
+                baseline = nullptr;
+            snapshot::ID.write(w, id);
+            w.write_bool(baseline != nullptr);
+            if (baseline) {
+                snapshot::BASELINE_DISTANCE.write(
+                    w, static_cast<snapshot_id_t>(id - baseline->id));
+                State::schema().write_delta(w, state, baseline->state);
+                ++_since_keyframe;
+            } else {
+                State::schema().write(w, state);
+                _since_keyframe = 0;
+            }
+
+            _history[id % RTYPE_SNAPSHOT_HISTORY]
+                = { true, false, false, id, 0, snapshot::quantize(state) };
+            _last = id;
+            return snapshot_payload(std::vector<Byte>(w.data()));
+        }
+
+        /**
+         * @brief Binds the last encoded snapshot to the packet that carries it
+         *
+         * @param packet The sequence of the packet (see feed_header)
+         */
+        void sent(feed_sequence_t packet)
+        {
+            if (!_last)
+                return;
+            entry& e = _history[*_last % RTYPE_SNAPSHOT_HISTORY];
+            e.sent = true;
+            e.packet = packet;
+            _last.reset();
+        }
+
+        /**
+         * @brief Tells whether the recipient already acked this state
+         *        (nothing needs to be sent)
+         */
+        bool up_to_date(const State& state, const reliable_endpoint& endpoint)
+        {
+            const entry* baseline = refresh(endpoint);
+
+            return baseline != nullptr
+                && State::schema().same(baseline->state, snapshot::quantize(state));
+        }
+
+        /**
+         * @brief Forgets every snapshot, the next one is a full state
+         */
+        void reset()
+        {
+            _history = {};
+            _last.reset();
+            _since_keyframe = 0;
+        }
+
+    private:
+        struct entry {
+            bool valid = false;
+            bool acked = false;
+            bool sent = false;
+            snapshot_id_t id = 0;
+            feed_sequence_t packet = 0;
+            State state;
+        };
+
+        // Updates the acks and gives the most recent acked snapshot
+        // (the receiver keeps every snapshot it received as a baseline, even
+        // one it did not apply, see snapshot_decoder::decode)
+        const entry* refresh(const reliable_endpoint& endpoint)
+        {
+            const entry* baseline = nullptr;
+            snapshot_id_t age = 0;
+
+            for (entry& e : _history) {
+                if (!e.valid)
+                    continue;
+                if (!e.acked && e.sent)
+                    e.acked = endpoint.acked(e.packet);
+                const snapshot_id_t distance = _next - e.id;
+                if (e.acked && distance < RTYPE_SNAPSHOT_HISTORY
+                    && (baseline == nullptr || distance < age)) {
+                    baseline = &e;
+                    age = distance;
+                }
+            }
+            return baseline;
+        }
+
+        std::array<entry, RTYPE_SNAPSHOT_HISTORY> _history;
+        // Kept as an id so a copy of the encoder stays valid
+        std::optional<snapshot_id_t> _last;
+        snapshot_id_t _next = 0;
+        std::size_t _since_keyframe = 0;
+    };
+
+    /**
+     * @brief Decodes what a snapshot_encoder encoded (not thread safe)
+     *        Snapshots may arrive out of order (see delivery::unreliable_unordered)
+     */
+    template <typename State> class snapshot_decoder {
+    public:
+        snapshot_decoder() = default;
+        ~snapshot_decoder() = default;
+
+        /**
+         * @brief Decodes a snapshot
+         *        A snapshot older than the last decoded one is still kept as
+         *        a baseline (the packet that carried it was acked) but it
+         *        must not be applied
+         *
+         * @param data The encoded snapshot
+         * @param size The size of the encoded snapshot
+         * @param state Filled with the decoded state
+         * @return bool false if the baseline of the snapshot is unknown or if
+         *         the snapshot is outdated (the snapshot must be ignored)
+         */
+        bool decode(const Byte* data, BufferSizeType size, State& state)
+        {
+            bit_reader r(data, size);
+            const snapshot_id_t id = snapshot::ID.read<snapshot_id_t>(r);
+            const snapshot_id_t age = _latest - id;
+            const bool outdated = _any && age < 0x80;
+
+            if (outdated && (age == 0 || age >= RTYPE_SNAPSHOT_HISTORY))
+                return false; // Duplicate or too old to be a baseline
+            if (r.read_bool()) {
+                const snapshot_id_t base = id
+                    - snapshot::BASELINE_DISTANCE.read<snapshot_id_t>(r);
+                const entry& baseline = _history[base % RTYPE_SNAPSHOT_HISTORY];
+
+                if (!baseline.valid || baseline.id != base)
+                    return false;
+                state = baseline.state;
+                State::schema().read_delta(r, state);
+            } else {
+                state = State();
+                State::schema().read(r, state);
+            }
+            _history[id % RTYPE_SNAPSHOT_HISTORY] = { true, id, state };
+            if (outdated)
+                return false;
+            _any = true;
+            _latest = id;
+            return true;
+        }
+
+        bool decode(const snapshot_payload& payload, State& state)
+        {
+            return decode(payload.bytes.data(), payload.bytes.size(), state);
+        }
+
+        /**
+         * @brief Forgets every snapshot
+         */
+        void reset()
+        {
+            _history = {};
+            _any = false;
+        }
+
+    private:
+        struct entry {
+            bool valid = false;
+            snapshot_id_t id = 0;
+            State state;
+        };
+
+        std::array<entry, RTYPE_SNAPSHOT_HISTORY> _history;
+        bool _any = false;
+        snapshot_id_t _latest = 0;
+    };
+
+}
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "RServer/Messages/Messages.hpp"
+
+#include <array>
+#include <bit>
+#include <functional>
+#include <map>
+#include <optional>
+#include <type_traits>
+
+namespace rtype {
+namespace net {
+
+// A checksum of the state is exchanged every RTYPE_DESYNC_INTERVAL ticks
+#ifndef RTYPE_DESYNC_INTERVAL
+#define RTYPE_DESYNC_INTERVAL 30
+#endif
+
+// Count of checksums remembered by a desync_detector
+#ifndef RTYPE_DESYNC_HISTORY
+#define RTYPE_DESYNC_HISTORY 64
+#endif
+
+    using state_tick_t = uint32_t;
+
+    /**
+     * @brief Incremental 64 bits FNV-1a hash
+     *        Values are hashed byte by byte from the least significant one
+     *        so the hash does not depend on the endianness
+     */
+    class state_hash {
+    public:
+        static constexpr uint64_t OFFSET = 14695981039346656037ull;
+        static constexpr uint64_t PRIME = 1099511628211ull;
+
+        state_hash() = default;
+        ~state_hash() = default;
+
+        state_hash& add(const Byte* data, std::size_t size)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+                _value = (_value ^ data[i]) * PRIME;
+            return *this;
+        }
+
+        template <typename T>
+        requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+        state_hash& add(T value)
+        {
+            uint64_t bits = 0;
+
+            if constexpr (std::is_same_v<T, float>)
+                bits = std::bit_cast<uint32_t>(value);
+            else if constexpr (std::is_same_v<T, double>)
+                bits = std::bit_cast<uint64_t>(value);
+            else
+                bits = static_cast<uint64_t>(value);
+            for (std::size_t i = 0; i < sizeof(T); ++i, bits >>= 8)
+                _value = (_value ^ (bits & 0xFF)) * PRIME;
+            return *this;
+        }
+
+        uint64_t value() const { return _value; }
+
+        void reset() { _value = OFFSET; }
+
+    private:
+        uint64_t _value = OFFSET;
+    };
+
+    /**
+     * @brief Checksum of the state of the simulation at a tick, to be
+     *        carried by an UpdateMessage (STATE_CHECKSUM)
+     *
+     *        Layout: tick (varint) then the hash (64 bits)
+     */
+    struct state_checksum : public Serializable {
+        state_tick_t tick = 0;
+        uint64_t hash = 0;
+
+        state_checksum() = default;
+
+        state_checksum(state_tick_t tick, uint64_t hash)
+            : tick(tick)
+            , hash(hash)
+        {
+        }
+
+        std::vector<Byte> serialize() const override;
+        void from(const Byte* data, const BufferSizeType size) override;
+    };
+
+    /**
+     * @brief Compares the checksums of the local simulation with the ones
+     *        of the other players and reports the first tick they differ
+     *        A checksum received before the local one of the same tick is
+     *        kept until it is computed
+     *        (not thread safe)
+     */
+    class desync_detector {
+    public:
+        // Called with the player and the tick of the first desync
+        using report_t = std::function<void(PlayerID, state_tick_t)>;
+
+        desync_detector(report_t report = nullptr);
+        ~desync_detector() = default;
+
+        /**
+         * @brief Records the checksum of the local simulation at a tick
+         */
+        void local(state_tick_t tick, uint64_t hash);
+
+        /**
+         * @brief Records the checksum of a player
+         */
+        void remote(PlayerID player, const state_checksum& checksum);
+
+        /**
+         * @brief The first tick the simulations differ, if any
+         */
+        std::optional<state_tick_t> first_desync() const { return _first; }
+
+        /**
+         * @brief Forgets every checksum and desync
+         */
+        void reset();
+
+    private:
+        void compare(PlayerID player, state_tick_t tick, uint64_t local, uint64_t remote);
+
+        report_t _report;
+        std::map<state_tick_t, uint64_t> _local;
+        std::map<state_tick_t, std::array<std::optional<uint64_t>, RTYPE_PLAYER_COUNT>> _pending;
+        std::optional<state_tick_t> _first;
+    };
+
+}
+}
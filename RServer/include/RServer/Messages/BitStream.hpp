@@ -0,0 +1,350 @@
+#pragma once
+
+#include "RServer/utils.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace rtype {
+namespace net {
+
+    /**
+     * @brief Writes values bit by bit (most significant bit first)
+     *        Nothing is aligned on bytes unless align() is called
+     */
+    class bit_writer {
+    public:
+        bit_writer() = default;
+        ~bit_writer() = default;
+
+        /**
+         * @brief Writes the count lowest bits of value
+         *
+         * @param value The value to write
+         * @param count The count of bits to write (at most 32)
+         */
+        bit_writer& write_bits(uint32_t value, unsigned count);
+
+        bit_writer& write_bool(bool value);
+
+        /**
+         * @brief Writes an unsigned integer in groups of 7 bits, each group
+         *        followed by a bit telling whether another group follows
+         */
+        bit_writer& write_varint(uint64_t value);
+
+        /**
+         * @brief Same as write_varint but zigzag encoded so small negative
+         *        values stay small
+         */
+        bit_writer& write_signed_varint(int64_t value);
+
+        /**
+         * @brief Pads with zeros up to the next byte
+         */
+        bit_writer& align();
+
+        /**
+         * @brief Count of bits written
+         */
+        std::size_t bit_size() const { return _bits; }
+
+        /**
+         * @brief The written bytes (the last byte is padded with zeros)
+         */
+        const std::vector<Byte>& data() const { return _data; }
+
+    private:
+        std::vector<Byte> _data;
+        std::size_t _bits = 0;
+    };
+
+    /**
+     * @brief Reads values written by a bit_writer
+     *        Throws std::runtime_error when reading past the end
+     */
+    class bit_reader {
+    public:
+        bit_reader(const Byte* data, BufferSizeType size)
+            : _data(data)
+            , _size(size)
+        {
+        }
+
+        bit_reader(const std::vector<Byte>& data)
+            : bit_reader(data.data(), data.size())
+        {
+        }
+
+        ~bit_reader() = default;
+
+        uint32_t read_bits(unsigned count);
+        bool read_bool();
+        uint64_t read_varint();
+        int64_t read_signed_varint();
+
+        /**
+         * @brief Skips the bits up to the next byte
+         */
+        bit_reader& align();
+
+        /**
+         * @brief Count of bytes started by the reads
+         */
+        BufferSizeType consumed_bytes() const { return (_bits + 7) / 8; }
+
+        /**
+         * @brief Count of bits that can still be read
+         */
+        std::size_t remaining_bits() const { return _size * 8 - _bits; }
+
+    private:
+        const Byte* _data;
+        BufferSizeType _size;
+        std::size_t _bits = 0;
+    };
+
+    namespace bits {
+
+        /**
+         * @brief Count of bits needed to write every value in [0, max]
+         */
+        constexpr unsigned width_of(uint64_t max)
+        {
+            return max ? static_cast<unsigned>(std::bit_width(max)) : 0;
+        }
+
+        /**
+         * @brief A boolean on one bit
+         */
+        struct flag {
+            constexpr unsigned width() const { return 1; }
+
+            template <typename T> void write(bit_writer& w, const T& value) const
+            {
+                w.write_bool(static_cast<bool>(value));
+            }
+
+            template <typename T> T read(bit_reader& r) const
+            {
+                return static_cast<T>(r.read_bool());
+            }
+        };
+
+        /**
+         * @brief An integer in [min, max] stored with the given step
+         *        (values out of range are clamped, the step rounds down)
+         */
+        struct ranged {
+            int64_t min = 0;
+            int64_t max = 0;
+            int64_t step = 1;
+
+            constexpr uint64_t steps() const
+            {
+                return static_cast<uint64_t>((max - min) / step);
+            }
+
+            constexpr unsigned width() const { return width_of(steps()); }
+
+            template <typename T> void write(bit_writer& w, const T& value) const
+            {
+                const int64_t v = std::clamp<int64_t>(
+                    static_cast<int64_t>(value), min, max);
+
+                w.write_bits(static_cast<uint32_t>((v - min) / step), width());
+            }
+
+            template <typename T> T read(bit_reader& r) const
+            {
+                const uint64_t v = std::min<uint64_t>(r.read_bits(width()), steps());
+
+                return static_cast<T>(min + static_cast<int64_t>(v) * step);
+            }
+        };
+
+        /**
+         * @brief A float in [min, max] rounded to the nearest multiple of
+         *        precision (values out of range are clamped)
+         */
+        struct quantized {
+            float min = 0.f;
+            float max = 0.f;
+            float precision = 1.f;
+
+            constexpr uint64_t steps() const
+            {
+                const float s = (max - min) / precision;
+                const uint64_t n = static_cast<uint64_t>(s);
+
+                return static_cast<float>(n) < s ? n + 1 : n;
+            }
+
+            constexpr unsigned width() const { return width_of(steps()); }
+
+            template <typename T> void write(bit_writer& w, const T& value) const
+            {
+                const float v = std::clamp(static_cast<float>(value), min, max);
+                const auto n = static_cast<uint64_t>(std::lround((v - min) / precision));
+
+                w.write_bits(static_cast<uint32_t>(std::min(n, steps())), width());
+            }
+
+            template <typename T> T read(bit_reader& r) const
+            {
+                const uint64_t n = std::min<uint64_t>(r.read_bits(width()), steps());
+
+                return static_cast<T>(
+                    std::min(min + static_cast<float>(n) * precision, max));
+            }
+        };
+
+        /**
+         * @brief An integer of any size, smaller values take less bits
+         *        (zigzag encoded for signed types)
+         */
+        struct varint {
+            template <typename T> void write(bit_writer& w, const T& value) const
+            {
+                if constexpr (std::is_signed_v<T>)
+                    w.write_signed_varint(static_cast<int64_t>(value));
+                else
+                    w.write_varint(static_cast<uint64_t>(value));
+            }
+
+            template <typename T> T read(bit_reader& r) const
+            {
+                if constexpr (std::is_signed_v<T>)
+                    return static_cast<T>(r.read_signed_varint());
+                else
+                    return static_cast<T>(r.read_varint());
+            }
+        };
+
+        /**
+         * @brief One field of a schema: an encoding and a projection that
+         *        gives access to the field in its owner
+         *        The projection must accept both const and non const owners,
+         *        usually [](auto& o) -> auto& { return o.member; }
+         */
+        template <typename Encoding, typename Projection> struct field {
+            Encoding encoding;
+            Projection projection;
+
+            template <typename Owner> void write(bit_writer& w, const Owner& owner) const
+            {
+                encoding.write(w, projection(owner));
+            }
+
+            template <typename Owner> void read(bit_reader& r, Owner& owner) const
+            {
+                auto& value = projection(owner);
+
+                value = encoding.template read<std::decay_t<decltype(value)>>(r);
+            }
+
+            template <typename Owner>
+            bool same(const Owner& a, const Owner& b) const
+            {
+                return projection(a) == projection(b);
+            }
+        };
+
+        template <typename Encoding, typename Projection>
+        constexpr field<Encoding, Projection> make_field(
+            Encoding encoding, Projection projection)
+        {
+            return { encoding, projection };
+        }
+
+        /**
+         * @brief Ordered list of the fields of a serialized type
+         *        Every field is written in the declaration order
+         */
+        template <typename... Fields> class schema {
+        public:
+            constexpr schema(Fields... fields)
+                : _fields(fields...)
+            {
+            }
+
+            static constexpr std::size_t size() { return sizeof...(Fields); }
+
+            template <typename Owner> void write(bit_writer& w, const Owner& owner) const
+            {
+                std::apply([&](const auto&... f) { (f.write(w, owner), ...); }, _fields);
+            }
+
+            template <typename Owner> void read(bit_reader& r, Owner& owner) const
+            {
+                std::apply([&](const auto&... f) { (f.read(r, owner), ...); }, _fields);
+            }
+
+            /**
+             * @brief Writes one bit per field telling whether it differs from
+             *        the baseline, followed by the value of the changed fields
+             */
+            template <typename Owner>
+            void write_delta(bit_writer& w, const Owner& owner,
+                const Owner& baseline) const
+            {
+                std::apply(
+                    [&](const auto&... f) {
+                        ((f.same(owner, baseline)
+                                 ? (void)w.write_bool(false)
+                                 : (w.write_bool(true), f.write(w, owner))),
+                            ...);
+                    },
+                    _fields);
+            }
+
+            /**
+             * @brief Reads what write_delta wrote, owner must hold the baseline
+             */
+            template <typename Owner> void read_delta(bit_reader& r, Owner& owner) const
+            {
+                std::apply(
+                    [&](const auto&... f) {
+                        ((r.read_bool() ? f.read(r, owner) : void()), ...);
+                    },
+                    _fields);
+            }
+
+            template <typename Owner> bool same(const Owner& a, const Owner& b) const
+            {
+                return std::apply(
+                    [&](const auto&... f) { return (f.same(a, b) && ...); },
+                    _fields);
+            }
+
+            template <typename Owner> std::vector<Byte> serialize(const Owner& owner) const
+            {
+                bit_writer w;
+
+                write(w, owner);
+                return w.data();
+            }
+
+            template <typename Owner>
+            void from(const Byte* data, BufferSizeType size, Owner& owner) const
+            {
+                bit_reader r(data, size);
+
+                read(r, owner);
+            }
+
+        protected:
+            std::tuple<Fields...> _fields;
+        };
+
+    }
+
+}
+}
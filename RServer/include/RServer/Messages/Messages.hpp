@@ -117,7 +117,13 @@ namespace net {
         UPDATE_PLAYER,
         UPDATE_ENEMY_DESTROYED,
         UPDATE_PLAYER_DESTROYED,
-        UPDATE_SCROLL
+        UPDATE_SCROLL,
+
+        // Lockstep messages
+        LOCKSTEP_INPUT,
+        STATE_CHECKSUM,
+        CLOCK_PING,
+        CLOCK_PONG
     };
 
     // All classes that inherit from IMessage
@@ -162,7 +168,13 @@ namespace net {
         UPDATE_PLAYER = UPDATE_MESSAGE,
         UPDATE_PLAYER_DESTROYED = UPDATE_MESSAGE,
         UPDATE_ENEMY_DESTROYED = UPDATE_MESSAGE,
-        UPDATE_SCROLL = UPDATE_MESSAGE
+        UPDATE_SCROLL = UPDATE_MESSAGE,
+
+        // Lockstep messages
+        LOCKSTEP_INPUT = UPDATE_MESSAGE,
+        STATE_CHECKSUM = UPDATE_MESSAGE,
+        CLOCK_PING = UPDATE_MESSAGE,
+        CLOCK_PONG = UPDATE_MESSAGE
 
     };
 
@@ -504,7 +516,7 @@ namespace net {
     class GameLauncher : public Message {
     public:
         GameLauncher() = default;
-        GameLauncher(int32_t seed, bool yes);
+        GameLauncher(int32_t seed, bool yes, Byte lockstep_delay = 0);
         ~GameLauncher() override = default;
 
         void from(const Byte* data, const BufferSizeType size) override;
@@ -514,9 +526,14 @@ namespace net {
         bool yes() const;
         int32_t seed() const;
 
+        // Input delay (in ticks) of the lockstep mode, 0 if the game uses the
+        // state updates instead
+        Byte lockstep_delay() const;
+
     private:
         Byte _yes = false;
         int32_t _seed = 0;
+        Byte _lockstep_delay = 0;
     };
 
 }
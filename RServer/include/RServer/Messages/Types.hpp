@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PileAA/meta.hpp"
+#include "RServer/Messages/BitStream.hpp"
 #include "RServer/Messages/Messages.hpp"
 #include <cstring>
 #include <vector>
@@ -59,6 +60,57 @@ namespace net {
         }
     };
 
+#ifndef RTYPE_PLAYER_STATE_MAX_X
+#define RTYPE_PLAYER_STATE_MAX_X 384
+#endif
+
+#ifndef RTYPE_PLAYER_STATE_MAX_Y
+#define RTYPE_PLAYER_STATE_MAX_Y 205
+#endif
+
+    using player_tick_t = uint8_t;
+
+    /**
+     * @brief State of a player as sent on the feed: the input and health
+     *        bits, the position relative to the scroll, quantized on
+     *        2 pixels, then the tick of the last local move that led to this
+     *        state (31 bits in total)
+     */
+    struct player_state : public Serializable {
+        uint8_t data = 0;
+        vector2i pos;
+        player_tick_t tick = 0;
+
+        player_state() = default;
+        player_state(const player_state& other) = default;
+        player_state& operator=(const player_state& other) = default;
+
+        static const auto& schema()
+        {
+            static constexpr bits::schema s(
+                bits::make_field(bits::ranged { 0, 0xFF },
+                    [](auto& p) -> auto& { return p.data; }),
+                bits::make_field(bits::ranged { 0, RTYPE_PLAYER_STATE_MAX_X, 2 },
+                    [](auto& p) -> auto& { return p.pos.x; }),
+                bits::make_field(bits::ranged { 0, RTYPE_PLAYER_STATE_MAX_Y, 2 },
+                    [](auto& p) -> auto& { return p.pos.y; }),
+                bits::make_field(bits::ranged { 0, 0xFF },
+                    [](auto& p) -> auto& { return p.tick; }));
+
+            return s;
+        }
+
+        std::vector<uint8_t> serialize() const override
+        {
+            return schema().serialize(*this);
+        }
+
+        void from(const uint8_t* data, const size_t size) override
+        {
+            schema().from(data, size, *this);
+        }
+    };
+
     struct srand_sync : public Serializable {
         int32_t seed = std::time(nullptr);
 
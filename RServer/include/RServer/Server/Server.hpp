@@ -4,6 +4,7 @@
 
 #include <variant>
 
+#include "RServer/Feed/Reliability.hpp"
 #include "RServer/Messages/Messages.hpp"
 
 #include "RServer/utils.hpp"
@@ -47,7 +48,7 @@ namespace net {
 
         message_code code()
         {
-            if (buffer.size() > StartOffset)
+            if (size > 0 && buffer.size() > StartOffset)
                 return static_cast<message_code>(buffer[StartOffset]);
             return message_code::DUMMY;
         }
@@ -214,7 +215,8 @@ namespace net {
         async_queue<tcp_event> _events;
     };
 
-#define RTYPE_UDP_MESSAGE_HEADER (sizeof(MagicNumber) + sizeof(ClientID))
+#define RTYPE_UDP_MESSAGE_HEADER                                               \
+    (sizeof(MagicNumber) + sizeof(ClientID) + feed_header::SIZE)
 
     class udp_server {
     public:
@@ -236,6 +238,19 @@ namespace net {
 
             ClientID sender_id();
 
+            const feed_header& header() const;
+
+            /**
+             * @brief The message after the headers
+             */
+            const Byte* payload() const;
+            BufferSizeType payload_size() const;
+
+            /**
+             * @brief When the message was received
+             */
+            clock_sync::clock::time_point received_at() const;
+
             HL_AUTO_COMPLETE_CANONICAL_FORM(message_info);
 
         private:
@@ -246,18 +261,19 @@ namespace net {
             ClientID _sender_id;
 
             MagicNumber _magic;
+
+            feed_header _header;
+
+            clock_sync::clock::time_point _received_at;
         };
 
         using shared_message_info_t = boost::shared_ptr<message_info>;
 
-        static shared_message_info_t new_message(
-            ClientID sender, const void* data, BufferSizeType size);
-
-        static shared_message_info_t new_message(
-            ClientID sender, const IMessage& msg);
+        static shared_message_info_t new_message(ClientID sender,
+            const feed_header& header, const void* data, BufferSizeType size);
 
         static shared_message_info_t new_message(
-            ClientID sender, const std::string& s);
+            ClientID sender, const feed_header& header, const IMessage& msg);
 
     private:
         void handle_receive_from(const boost::system::error_code& error,
@@ -272,6 +288,12 @@ namespace net {
 
         udp_server(boost::asio::io_context& io_context, PortType port);
 
+        /**
+         * @brief The reference clock of the feed, the clients synchronize
+         *        with it and the shared tick comes from it
+         */
+        const clock_sync& clock() const;
+
     private:
         udp::socket _socket;
         udp::endpoint _sender_endpoint;
@@ -279,6 +301,8 @@ namespace net {
         boost::shared_ptr<udp_buffer_t> _recv_buffer;
         boost::shared_ptr<async_automated_sparse_array<message_info>> _messages;
         boost::shared_ptr<async_queue<shared_message_info_t>> _recv_queue;
+
+        clock_sync _clock;
     };
 
     class remote_client : public boost::enable_shared_from_this<remote_client> {
@@ -313,23 +337,54 @@ namespace net {
 
         void send_feed(udp_server::shared_message_info_t msg);
 
-        void send_feed(const std::string& s);
+        feed_header send_feed(const std::string& s);
 
-        void send_feed(const void* data, BufferSizeType size);
+        feed_header send_feed(const void* data, BufferSizeType size);
 
-        void send_feed(const rtype::net::IMessage& message);
+        feed_header send_feed(const rtype::net::IMessage& message);
 
-        void send_feed(rtype::net::IMessage& message);
+        feed_header send_feed(rtype::net::IMessage& message);
 
         ClientID id() const;
 
         udp::endpoint get_feed_endpoint() const;
 
+        /**
+         * @brief Processes the reliability header of a message received on
+         *        the feed and appends the messages that can be delivered
+         *
+         * @param msg The received message
+         * @param ready The messages to deliver (in order)
+         */
+        void receive_feed(udp_server::shared_message_info_t msg,
+            std::vector<udp_server::shared_message_info_t>& ready);
+
+        /**
+         * @brief Resends the unacked reliable messages and sends the pending
+         *        acks of the feed channel
+         *
+         * @return false if the client stopped acking the feed, it is closed
+         *         (see reliable_endpoint::lost)
+         */
+        bool update_feed();
+
+        /**
+         * @brief Gets the reliability state of the feed channel
+         *        (tells which packets the client acked)
+         */
+        const reliable_endpoint& feed_reliability() const;
+
     private:
+        void send_feed_packet(const feed_header& header, const void* data,
+            BufferSizeType size);
+
         ClientID _main_id;
         udp::endpoint _feed_endpoint;
         tcp_server* _main_channel;
         udp_server* _feed_channel;
+
+        reliable_endpoint _feed_reliability;
+        ordered_delivery<udp_server::shared_message_info_t> _feed_ordered;
     };
     class server {
     public:
@@ -426,9 +481,13 @@ namespace net {
         bool poll_udp(event& event, udp_server::shared_message_info_t& msg);
         bool on_udp_feed_init(
             event& event, udp_server::shared_message_info_t& msg);
+        bool on_udp_clock_ping(
+            event& event, udp_server::shared_message_info_t& msg);
         bool on_udp_event_message(
             event& event, udp_server::shared_message_info_t& msg);
 
+        void update_feed();
+
     public:
         remote_client::pointer get_client(ClientID id);
 
@@ -444,6 +503,11 @@ namespace net {
 
         std::unordered_map<ClientID, remote_client::pointer> _clients;
 
+        std::deque<udp_server::shared_message_info_t> _feed_ready;
+        reliable_endpoint::clock::time_point _last_feed_update;
+        // Clients whose feed was lost, polled as disconnections
+        std::deque<remote_client::pointer> _feed_lost;
+
         boost::shared_ptr<boost::thread> _thread_io_context_runner;
 
         std::atomic_bool _is_running = false;
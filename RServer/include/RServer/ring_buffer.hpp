@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace rtype {
+namespace net {
+
+#ifndef RTYPE_RING_BUFFER_DEFAULT_CAPACITY
+#define RTYPE_RING_BUFFER_DEFAULT_CAPACITY 32
+#endif
+
+    /**
+     * @brief Fixed capacity FIFO that stores its elements by value
+     *        Slots are reused once popped so an element that owns memory
+     *        (a std::vector for example) keeps its capacity between uses
+     *        When full the buffer doubles its capacity instead of dropping
+     *        (this is not thread safe)
+     */
+    template <typename T> class ring_buffer {
+    public:
+        ring_buffer(std::size_t capacity = RTYPE_RING_BUFFER_DEFAULT_CAPACITY)
+            : _slots(capacity ? capacity : 1)
+        {
+        }
+
+        ~ring_buffer() = default;
+
+        ring_buffer(const ring_buffer&) = default;
+        ring_buffer(ring_buffer&&) noexcept = default;
+        ring_buffer& operator=(const ring_buffer&) = default;
+        ring_buffer& operator=(ring_buffer&&) noexcept = default;
+
+        /**
+         * @brief Gets the slot that the next commit() will push
+         *        The slot may still hold the value of an old element
+         *
+         * @return T& The slot to fill
+         */
+        T& next()
+        {
+            if (_size == _slots.size())
+                grow();
+            return _slots[(_head + _size) % _slots.size()];
+        }
+
+        /**
+         * @brief Pushes the slot previously returned by next()
+         */
+        void commit() { ++_size; }
+
+        /**
+         * @brief Pushes a copy of the value
+         */
+        void push(const T& value)
+        {
+            next() = value;
+            commit();
+        }
+
+        /**
+         * @brief Pushes the value
+         */
+        void push(T&& value)
+        {
+            next() = std::move(value);
+            commit();
+        }
+
+        /**
+         * @brief Gets the oldest element (the buffer must not be empty)
+         */
+        T& front() { return _slots[_head]; }
+
+        /**
+         * @brief Gets the oldest element (the buffer must not be empty)
+         */
+        const T& front() const { return _slots[_head]; }
+
+        /**
+         * @brief Removes the oldest element (the buffer must not be empty)
+         */
+        void pop()
+        {
+            _head = (_head + 1) % _slots.size();
+            --_size;
+        }
+
+        /**
+         * @brief Removes every element but keeps the slots allocated
+         */
+        void clear()
+        {
+            _head = 0;
+            _size = 0;
+        }
+
+        bool empty() const { return _size == 0; }
+
+        std::size_t size() const { return _size; }
+
+        std::size_t capacity() const { return _slots.size(); }
+
+    private:
+        void grow()
+        {
+            std::vector<T> slots(_slots.size() * 2);
+
+            for (std::size_t i = 0; i < _size; ++i)
+                slots[i] = std::move(_slots[(_head + i) % _slots.size()]);
+            _slots = std::move(slots);
+            _head = 0;
+        }
+
+        std::vector<T> _slots;
+        std::size_t _head = 0;
+        std::size_t _size = 0;
+    };
+
+}
+}
@@ -18,5 +18,12 @@ namespace net {
         return _queue.async_push(message);
     }
 
+    void AClient::set_inbox(inbox* inbox) { _inbox = inbox; }
+
+    BufferSizeType AClient::route_event(const Byte* data, BufferSizeType size)
+    {
+        return _inbox ? _inbox->push(data, size) : 0;
+    }
+
 }
 }
\ No newline at end of file
@@ -25,6 +25,8 @@ namespace net {
         , _udp_client(_udp_io_context, host_udp, udp_port)
         , _tcp_client(_tcp_io_context, host_tcp, tcp_port)
     {
+        _udp_client.set_inbox(&_inbox);
+        _tcp_client.set_inbox(&_inbox);
         _is_running = true;
         run();
     }
@@ -42,6 +44,8 @@ namespace net {
 
     TCPClient& UDP_TCP_Client::tcp() { return _tcp_client; }
 
+    inbox& UDP_TCP_Client::get_inbox() { return _inbox; }
+
     bool UDP_TCP_Client::should_restart() const
     {
         return _tcp_client.stopped() || _udp_client.stopped();
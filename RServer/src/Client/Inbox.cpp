@@ -0,0 +1,72 @@
+#include "RServer/Client/Inbox.hpp"
+
+namespace rtype {
+namespace net {
+
+    void inbox::set_route(message_code code, std::unique_ptr<ichannel> route)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _routes[static_cast<Byte>(code)] = std::move(route);
+    }
+
+    void inbox::off(message_code code) { set_route(code, nullptr); }
+
+    void inbox::reset()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& route : _routes)
+            route = nullptr;
+    }
+
+    BufferSizeType inbox::push(const Byte* data, BufferSizeType size)
+    {
+        if (size == 0)
+            return 0;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& route = _routes[data[0]];
+
+        if (route == nullptr)
+            return 0;
+        try {
+            return route->decode(data, size, _sequence++);
+        } catch (const std::exception& e) {
+            spdlog::error("inbox::push: Invalid message of code {}: {}",
+                static_cast<int>(data[0]), e.what());
+        }
+        return 0;
+    }
+
+    std::size_t inbox::drain()
+    {
+        std::size_t count = 0;
+
+        _draining.clear();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto& route : _routes) {
+                if (route == nullptr)
+                    continue;
+                route->swap();
+                if (route->pending())
+                    _draining.push_back(route.get());
+            }
+        }
+
+        // Merge the buffers back in arrival order
+        while (!_draining.empty()) {
+            auto oldest = _draining.begin();
+            for (auto it = _draining.begin() + 1; it != _draining.end(); ++it) {
+                if ((*it)->front_sequence() < (*oldest)->front_sequence())
+                    oldest = it;
+            }
+            (*oldest)->dispatch_front();
+            ++count;
+            if (!(*oldest)->pending())
+                _draining.erase(oldest);
+        }
+        return count;
+    }
+
+}
+}
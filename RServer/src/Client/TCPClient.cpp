@@ -59,9 +59,23 @@ namespace net {
                 if (!ec) {
                     spdlog::info(
                         "TCPClient::receive: Received {} bytes", bytes);
-                    auto msg = parse_messages(_buf_recv->c_array(), bytes);
-                    for (auto& m : msg) {
-                        _add_event(m);
+                    const Byte* data = _buf_recv->c_array();
+                    BufferSizeType offset = 0;
+                    while (offset < bytes) {
+                        const BufferSizeType routed
+                            = route_event(data + offset, bytes - offset);
+                        if (routed != 0) {
+                            offset += routed;
+                            continue;
+                        }
+                        auto msg = parse_message(data + offset, bytes - offset);
+                        if (msg == nullptr) {
+                            spdlog::error("TCPClient::receive: Message is "
+                                          "null skipping everything else");
+                            break;
+                        }
+                        _add_event(msg);
+                        offset += msg->size();
                     }
                     receive();
                 } else {
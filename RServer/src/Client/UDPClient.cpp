@@ -29,21 +29,22 @@ namespace net {
         , _receiver_endpoint(*_resolver.resolve({ host, port }))
         , _socket(io_context)
         , _sender_endpoint()
+        , _feed_timer(io_context)
         , _buf_recv(new udp_buffer_t)
     {
+        _feed_reliability.set_clock(&_clock);
         _socket.open(boost::asio::ip::udp::v4());
         _socket.connect(_receiver_endpoint);
         _stopped = false;
 
         receive();
+        schedule_feed_update();
     }
 
     void UDPClient::feed_request(TokenType token, ClientID playerId)
     {
-        auto msg = FeedInitRequest(playerId, token);
-        auto shared_message = udp_server::new_message(playerId, msg);
         _id = playerId;
-        this->send(shared_message, shared_message->size());
+        this->send(FeedInitRequest(playerId, token));
     }
 
     void UDPClient::_add_event(shared_message_t& message)
@@ -75,23 +76,105 @@ namespace net {
                     return;
                 }
                 HeaderMessage header(*buf_recv);
-                if (!header.is_valid()) {
+                if (!header.is_valid() || bytes < RTYPE_UDP_MESSAGE_HEADER) {
                     spdlog::info("UDPClient::receive: Invalid Magic !");
+                    receive();
                     return;
                 }
-                auto msg
-                    = parse_message(reinterpret_cast<Byte*>(_buf_recv->c_array()
-                                        + RTYPE_UDP_MESSAGE_HEADER),
-                        bytes - RTYPE_UDP_MESSAGE_HEADER);
-                if (msg == nullptr) {
-                    spdlog::error("UDPClient::receive: Invalid message");
-                } else {
-                    _add_event(msg);
+                const Byte* data = _buf_recv->c_array() + RTYPE_UDP_MESSAGE_HEADER;
+                const BufferSizeType size = bytes - RTYPE_UDP_MESSAGE_HEADER;
+                feed_header feed;
+                try {
+                    feed.from(_buf_recv->c_array() + header.size(),
+                        feed_header::SIZE);
+                } catch (const std::exception& e) {
+                    spdlog::error("UDPClient::receive: {}", e.what());
+                    receive();
+                    return;
+                }
+                switch (_feed_reliability.receive(feed, data, size)) {
+                case reliable_endpoint::verdict::deliver:
+                    deliver(data, size);
+                    break;
+                case reliable_endpoint::verdict::ordered: {
+                    std::vector<std::vector<Byte>> ready;
+                    _feed_ordered.push(feed.channel_sequence,
+                        std::vector<Byte>(data, data + size), ready);
+                    for (auto& message : ready)
+                        deliver(message.data(), message.size());
+                    break;
+                }
+                default:
+                    break;
                 }
                 receive();
             });
     }
 
+    void UDPClient::deliver(const Byte* data, BufferSizeType size)
+    {
+        if (size == 0)
+            return;
+        if (static_cast<message_code>(data[0]) == message_code::CLOCK_PONG) {
+            on_clock_pong(data, size);
+            return;
+        }
+        if (route_event(data, size) != 0)
+            return;
+        auto msg = parse_message(data, size);
+        if (msg == nullptr) {
+            spdlog::error("UDPClient::receive: Invalid message");
+        } else {
+            _add_event(msg);
+        }
+    }
+
+    void UDPClient::on_clock_pong(const Byte* data, BufferSizeType size)
+    {
+        const auto received = clock_sync::clock::now();
+
+        try {
+            auto update = parse_message<UpdateMessage>(data, size);
+            if (update == nullptr)
+                return;
+            clock_pong pong;
+            pong.from(update->data().data(), update->data().size());
+            _clock.on_pong(pong, received);
+        } catch (const std::exception& e) {
+            spdlog::error("UDPClient::on_clock_pong: {}", e.what());
+        }
+    }
+
+    void UDPClient::schedule_feed_update()
+    {
+        _feed_timer.expires_after(std::chrono::milliseconds(RTYPE_FEED_UPDATE_MS));
+        _feed_timer.async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+                return;
+            std::vector<reliable_endpoint::packet> packets;
+            _feed_reliability.update(packets);
+            for (auto& packet : packets) {
+                send_packet(packet.header, packet.payload.data(),
+                    packet.payload.size());
+            }
+            if (_connected && _feed_reliability.lost()) {
+                spdlog::error("UDPClient: The server stopped acking the feed");
+                _connected = false;
+            }
+            if (_connected && _clock.should_ping())
+                send(UpdateMessage(static_cast<PlayerID>(_id), _clock.ping(),
+                    message_code::CLOCK_PING));
+            schedule_feed_update();
+        });
+    }
+
+    void UDPClient::send_packet(
+        const feed_header& header, const Byte* data, BufferSizeType size)
+    {
+        auto shared_message = udp_server::new_message(_id, header, data, size);
+        this->send(shared_message, shared_message->size());
+    }
+
     void UDPClient::send(rtype::net::udp_server::shared_message_info_t message,
         BufferSizeType size)
     {
@@ -111,10 +194,21 @@ namespace net {
             });
     }
 
-    void UDPClient::send(const IMessage& msg)
+    feed_header UDPClient::send(const IMessage& msg)
     {
-        auto shared_message = udp_server::new_message(_id, msg);
-        this->send(shared_message, shared_message->size());
+        const auto bytes = msg.serialize();
+        const feed_header header
+            = _feed_reliability.send(bytes.data(), bytes.size());
+
+        send_packet(header, bytes.data(), bytes.size());
+        return header;
+    }
+
+    const clock_sync& UDPClient::clock() const { return _clock; }
+
+    const reliable_endpoint& UDPClient::feed_reliability() const
+    {
+        return _feed_reliability;
     }
 
     bool UDPClient::is_connected() const { return _connected; }
@@ -0,0 +1,150 @@
+#include "RServer/Feed/Clock.hpp"
+#include "RServer/Messages/BitStream.hpp"
+
+#include <algorithm>
+
+namespace rtype {
+namespace net {
+
+    std::vector<Byte> clock_ping::serialize() const
+    {
+        bit_writer w;
+
+        w.write_signed_varint(origin);
+        return w.data();
+    }
+
+    void clock_ping::from(const Byte* data, const BufferSizeType size)
+    {
+        bit_reader r(data, size);
+
+        origin = r.read_signed_varint();
+    }
+
+    std::vector<Byte> clock_pong::serialize() const
+    {
+        bit_writer w;
+
+        w.write_signed_varint(origin)
+            .write_signed_varint(receive)
+            .write_signed_varint(transmit);
+        return w.data();
+    }
+
+    void clock_pong::from(const Byte* data, const BufferSizeType size)
+    {
+        bit_reader r(data, size);
+
+        origin = r.read_signed_varint();
+        receive = r.read_signed_varint();
+        transmit = r.read_signed_varint();
+    }
+
+    clock_sync::clock_sync()
+        : _epoch(clock::now())
+        , _next_ping(_epoch)
+    {
+    }
+
+    clock_time_t clock_sync::time(clock::time_point point) const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            point - _epoch)
+            .count();
+    }
+
+    clock_time_t clock_sync::server_time(clock::time_point point) const
+    {
+        return time(point) + offset();
+    }
+
+    feed_tick_t clock_sync::tick(clock::time_point point) const
+    {
+        const clock_time_t t = server_time(point);
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (t > 0)
+            _last_tick = std::max(_last_tick,
+                static_cast<feed_tick_t>(t / TICK_DURATION));
+        return _last_tick;
+    }
+
+    bool clock_sync::should_ping(clock::time_point point)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (point < _next_ping)
+            return false;
+        _next_ping = point
+            + std::chrono::milliseconds(_count < RTYPE_CLOCK_SAMPLES
+                    ? RTYPE_CLOCK_FAST_PING_MS
+                    : RTYPE_CLOCK_PING_MS);
+        return true;
+    }
+
+    clock_ping clock_sync::ping(clock::time_point point) const
+    {
+        clock_ping p;
+
+        p.origin = time(point);
+        return p;
+    }
+
+    clock_pong clock_sync::pong(const clock_ping& ping, clock::time_point received) const
+    {
+        clock_pong p;
+
+        p.origin = ping.origin;
+        p.receive = time(received);
+        p.transmit = time();
+        return p;
+    }
+
+    void clock_sync::on_pong(const clock_pong& pong, clock::time_point received)
+    {
+        const clock_time_t destination = time(received);
+        sample s;
+
+        // Time spent on the network, without the time the server held it
+        s.rtt = (destination - pong.origin) - (pong.transmit - pong.receive);
+        s.offset = ((pong.receive - pong.origin) + (pong.transmit - destination)) / 2;
+        if (s.rtt < 0 || pong.origin > destination)
+            return;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _samples[_next] = s;
+        _next = (_next + 1) % RTYPE_CLOCK_SAMPLES;
+        _count = std::min<std::size_t>(_count + 1, RTYPE_CLOCK_SAMPLES);
+
+        // The sample that waited the least in queues is the most accurate
+        const auto best = std::min_element(_samples.begin(),
+            _samples.begin() + _count,
+            [](const sample& a, const sample& b) { return a.rtt < b.rtt; });
+        _offset = best->offset;
+        _rtt = _count == 1 ? s.rtt : _rtt + (s.rtt - _rtt) / 8;
+    }
+
+    clock_time_t clock_sync::offset() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        return _offset;
+    }
+
+    clock_time_t clock_sync::rtt() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        return _rtt;
+    }
+
+    bool clock_sync::synchronized() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        return _count != 0;
+    }
+
+}
+}
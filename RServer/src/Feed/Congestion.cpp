@@ -0,0 +1,104 @@
+#include "RServer/Feed/Congestion.hpp"
+
+#include <algorithm>
+
+namespace rtype {
+namespace net {
+
+    namespace {
+        // Weight of a new sample in the smoothed values
+        constexpr double RTT_GAIN = 0.125;
+        constexpr double LOSS_GAIN = 0.05;
+        constexpr double BANDWIDTH_GAIN = 0.25;
+
+        // The bandwidth is measured on periods of this duration
+        constexpr auto BANDWIDTH_PERIOD = std::chrono::milliseconds(250);
+
+        // Only the 33 packets before its last ack are acked by the peer
+        constexpr feed_sequence_t ACK_WINDOW = 33;
+
+        double seconds(link_estimator::clock::duration d)
+        {
+            return std::chrono::duration<double>(d).count();
+        }
+    }
+
+    void link_estimator::on_sent(
+        feed_sequence_t sequence, std::size_t bytes, clock::time_point now)
+    {
+        sent_packet& slot = _sent[sequence % WINDOW];
+
+        // The packet that had this slot was neither acked nor expired
+        if (slot.valid)
+            resolve(slot, true);
+        slot = { true, sequence, now };
+        on_untracked(bytes);
+    }
+
+    void link_estimator::on_untracked(std::size_t bytes)
+    {
+        const auto now = clock::now();
+
+        _bytes += bytes;
+        if (now - _bytes_since >= BANDWIDTH_PERIOD) {
+            const double rate = _bytes / seconds(now - _bytes_since);
+            _bandwidth += (rate - _bandwidth) * BANDWIDTH_GAIN;
+            _bytes = 0;
+            _bytes_since = now;
+        }
+    }
+
+    void link_estimator::on_acked(feed_sequence_t sequence, clock::time_point now)
+    {
+        sent_packet& slot = _sent[sequence % WINDOW];
+
+        if (!slot.valid || slot.sequence != sequence)
+            return;
+        const double sample = seconds(now - slot.time);
+        _rtt = _rtt_any ? _rtt + (sample - _rtt) * RTT_GAIN : sample;
+        _rtt_any = true;
+        resolve(slot, false);
+    }
+
+    void link_estimator::expire(feed_sequence_t ack, clock::time_point now)
+    {
+        // Late acks are still possible for a while after a round trip
+        const auto timeout = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(std::max(_rtt * 4, 1.0)));
+
+        for (sent_packet& slot : _sent) {
+            if (!slot.valid)
+                continue;
+            if ((sequence_greater_than(ack, slot.sequence)
+                    && static_cast<feed_sequence_t>(ack - slot.sequence) >= ACK_WINDOW)
+                || now - slot.time > timeout)
+                resolve(slot, true);
+        }
+    }
+
+    void link_estimator::resolve(sent_packet& packet, bool lost)
+    {
+        _loss += ((lost ? 1.0 : 0.0) - _loss) * LOSS_GAIN;
+        packet.valid = false;
+    }
+
+    void rate_controller::update(const link_estimator& link, clock::time_point now)
+    {
+        const auto period = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(
+                std::max(link.rtt(), RTYPE_FEED_MIN_INTERVAL_MS / 1000.0)));
+
+        if (now - _last < period)
+            return;
+        _last = now;
+        if (link.loss() > RTYPE_FEED_TARGET_LOSS
+            || link.bandwidth() > RTYPE_FEED_TARGET_BANDWIDTH)
+            _interval *= 2;
+        else
+            _interval -= STEP;
+        _interval = std::clamp<double>(_interval, RTYPE_FEED_MIN_INTERVAL_MS,
+            RTYPE_FEED_MAX_INTERVAL_MS);
+    }
+
+}
+}
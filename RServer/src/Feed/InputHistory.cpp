@@ -0,0 +1,76 @@
+#include "RServer/Feed/InputHistory.hpp"
+
+namespace rtype {
+namespace net {
+
+    namespace {
+        constexpr bits::ranged INPUT_COUNT { 0, RTYPE_INPUT_HISTORY };
+    }
+
+    std::vector<Byte> player_update::serialize() const
+    {
+        const std::size_t count
+            = std::min<std::size_t>(inputs.size(), RTYPE_INPUT_HISTORY);
+        bit_writer w;
+
+        w.write_varint(snapshot.bytes.size());
+        for (const Byte b : snapshot.bytes)
+            w.write_bits(b, 8);
+        INPUT_COUNT.write(w, count);
+        for (std::size_t i = 0; i < count; ++i) {
+            w.write_varint(i == 0 ? inputs[i].tick
+                                  : inputs[i - 1].tick - inputs[i].tick);
+            w.write_bits(inputs[i].bits, RTYPE_INPUT_BITS);
+        }
+        return w.data();
+    }
+
+    void player_update::from(const Byte* data, const BufferSizeType size)
+    {
+        bit_reader r(data, size);
+
+        const uint64_t length = r.read_varint();
+        if (length > r.remaining_bits() / 8)
+            throw std::runtime_error("Cannot extract data");
+        snapshot.bytes.resize(length);
+        for (Byte& b : snapshot.bytes)
+            b = static_cast<Byte>(r.read_bits(8));
+
+        inputs.resize(INPUT_COUNT.read<std::size_t>(r));
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            const auto tick = static_cast<feed_tick_t>(r.read_varint());
+            inputs[i].tick = i == 0 ? tick : inputs[i - 1].tick - tick;
+            inputs[i].bits = static_cast<input_bits_t>(r.read_bits(RTYPE_INPUT_BITS));
+        }
+    }
+
+    bool input_history::push(feed_tick_t tick, input_bits_t bits)
+    {
+        if (!_frames.empty()) {
+            if (_frames.front().bits == bits)
+                return false;
+            tick = std::max<feed_tick_t>(tick, _frames.front().tick + 1);
+        }
+        _frames.push_front({ tick, bits });
+        if (_frames.size() > RTYPE_INPUT_HISTORY)
+            _frames.pop_back();
+        return true;
+    }
+
+    std::vector<input_frame> input_receiver::receive(
+        const std::vector<input_frame>& frames)
+    {
+        std::vector<input_frame> unseen;
+
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            if (_any && it->tick <= _last)
+                continue;
+            unseen.push_back(*it);
+            _any = true;
+            _last = it->tick;
+        }
+        return unseen;
+    }
+
+}
+}
@@ -0,0 +1,78 @@
+#include "RServer/Feed/Interest.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rtype {
+namespace net {
+
+    namespace {
+        // Bytes the budget may hold, a recipient that got nothing for a
+        // while does not get a burst
+        constexpr double MAX_BUDGET
+            = RTYPE_INTEREST_BANDWIDTH * RTYPE_FEED_MAX_INTERVAL_MS / 1000.0;
+    }
+
+    bool interest_view::contains(const interest_point& pos) const
+    {
+        return pos.x >= origin.x - RTYPE_INTEREST_MARGIN
+            && pos.x <= origin.x + size.x + RTYPE_INTEREST_MARGIN
+            && pos.y >= origin.y - RTYPE_INTEREST_MARGIN
+            && pos.y <= origin.y + size.y + RTYPE_INTEREST_MARGIN;
+    }
+
+    double interest_manager::priority(
+        const interest_view& view, const interest_candidate& candidate)
+    {
+        if (!view.contains(candidate.pos))
+            return 0;
+        if (!view.focus)
+            return candidate.relevance;
+
+        const double distance = std::hypot(candidate.pos.x - view.focus->x,
+            candidate.pos.y - view.focus->y);
+        return candidate.relevance / (1 + distance / RTYPE_INTEREST_RANGE);
+    }
+
+    std::vector<interest_id_t> interest_manager::rank(const interest_view& view,
+        const std::vector<interest_candidate>& candidates)
+    {
+        std::vector<interest_id_t> ranked;
+
+        for (const auto& candidate : candidates) {
+            const double p = priority(view, candidate);
+            if (p <= 0)
+                continue;
+            _accumulators[candidate.id] += p;
+            ranked.push_back(candidate.id);
+        }
+        std::stable_sort(ranked.begin(), ranked.end(),
+            [this](interest_id_t a, interest_id_t b) {
+                return _accumulators[a] > _accumulators[b];
+            });
+        return ranked;
+    }
+
+    void interest_manager::sent(interest_id_t id, std::size_t bytes)
+    {
+        _accumulators[id] = 0;
+        _budget -= bytes;
+    }
+
+    void interest_manager::refill(clock::time_point now)
+    {
+        const double elapsed = std::chrono::duration<double>(now - _refilled).count();
+
+        _refilled = now;
+        _budget = std::min(_budget + elapsed * RTYPE_INTEREST_BANDWIDTH, MAX_BUDGET);
+    }
+
+    void interest_manager::reset()
+    {
+        _accumulators.clear();
+        _budget = 0;
+        _refilled = clock::now();
+    }
+
+}
+}
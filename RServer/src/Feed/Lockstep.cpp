@@ -0,0 +1,192 @@
+#include "RServer/Feed/Lockstep.hpp"
+
+namespace rtype {
+namespace net {
+
+    std::vector<Byte> lockstep_input::serialize() const
+    {
+        bit_writer w;
+
+        w.write_varint(tick).write_varint(inputs.size());
+        for (const lockstep_input_t input : inputs)
+            w.write_bits(input, sizeof(lockstep_input_t) * 8);
+        return w.data();
+    }
+
+    void lockstep_input::from(const Byte* data, const BufferSizeType size)
+    {
+        bit_reader r(data, size);
+
+        tick = static_cast<lockstep_tick_t>(r.read_varint());
+        const uint64_t count = r.read_varint();
+        if (count > r.remaining_bits() / (sizeof(lockstep_input_t) * 8))
+            throw std::runtime_error("Cannot extract data");
+        inputs.resize(count);
+        for (lockstep_input_t& input : inputs)
+            input = static_cast<lockstep_input_t>(
+                r.read_bits(sizeof(lockstep_input_t) * 8));
+    }
+
+    lockstep_session::lockstep_session(PlayerID local,
+        const std::array<Bool, RTYPE_PLAYER_COUNT>& players,
+        std::size_t input_delay, callbacks cb, double timestep)
+        : _local(local)
+        , _delay(input_delay)
+        , _timestep(timestep)
+        , _callbacks(std::move(cb))
+    {
+        for (PlayerID i = 0; i < RTYPE_PLAYER_COUNT; ++i)
+            if (players[i])
+                _players |= 1 << i;
+
+        // Nobody can have sampled an input for the first ticks
+        for (lockstep_tick_t t = 1; t <= _delay; ++t)
+            _frames[t].known = 0xFF;
+        _outgoing.tick = _delay + 1;
+        if (predicts() && _callbacks.save)
+            _callbacks.save(0);
+    }
+
+    bool lockstep_session::complete(const frame& f) const
+    {
+        return (f.known & _players) == _players;
+    }
+
+    bool lockstep_session::predicted(const frame& f) const
+    {
+        for (PlayerID i = 0; i < RTYPE_PLAYER_COUNT; ++i) {
+            const lockstep_input_t input
+                = _players & (1 << i) ? f.inputs[i] : 0;
+            if (f.used[i] != input)
+                return false;
+        }
+        return true;
+    }
+
+    bool lockstep_session::predicts() const
+    {
+        return static_cast<bool>(_callbacks.load);
+    }
+
+    void lockstep_session::simulate()
+    {
+        const lockstep_tick_t t = _simulated + 1;
+        frame& f = _frames[t];
+
+        for (PlayerID i = 0; i < RTYPE_PLAYER_COUNT; ++i) {
+            if (!(_players & (1 << i)))
+                f.used[i] = 0;
+            else
+                f.used[i] = f.known & (1 << i) ? f.inputs[i] : _previous[i];
+        }
+        _callbacks.step(t, f.used);
+        f.simulated = true;
+        _previous = f.used;
+        _simulated = t;
+        if (predicts() && _callbacks.save)
+            _callbacks.save(t);
+        confirm();
+    }
+
+    void lockstep_session::confirm()
+    {
+        // A correct prediction needs no new simulation, the state saved
+        // after the tick becomes the confirmed one
+        for (auto it = _frames.find(_confirmed + 1);
+             it != _frames.end() && it->first == _confirmed + 1;
+             it = _frames.erase(it)) {
+            if (!it->second.simulated || !complete(it->second)
+                || !predicted(it->second))
+                break;
+            _confirmed = it->first;
+            _confirmed_inputs = it->second.used;
+            if (_callbacks.confirm)
+                _callbacks.confirm(_confirmed);
+        }
+    }
+
+    void lockstep_session::rollback()
+    {
+        const lockstep_tick_t target = _simulated;
+
+        _rollback = false;
+        ++_rollbacks;
+        _callbacks.load(_confirmed);
+        _simulated = _confirmed;
+        _previous = _confirmed_inputs;
+        for (auto& it : _frames)
+            it.second.simulated = false;
+        while (_simulated < target)
+            simulate();
+    }
+
+    void lockstep_session::update(double dt)
+    {
+        _accumulator = std::min(
+            _accumulator + dt, _timestep * RTYPE_LOCKSTEP_MAX_ROLLBACK);
+
+        if (_rollback)
+            rollback();
+
+        while (_accumulator >= _timestep
+            && _simulated - _confirmed < RTYPE_LOCKSTEP_MAX_ROLLBACK) {
+            const lockstep_tick_t t = _simulated + 1 + _delay;
+            if (_players & (1 << _local)) {
+                frame& f = _frames[t];
+                if (!(f.known & (1 << _local))) {
+                    f.inputs[_local] = _callbacks.input();
+                    f.known |= 1 << _local;
+                    if (_outgoing.inputs.empty())
+                        _outgoing.tick = t;
+                    _outgoing.inputs.push_back(f.inputs[_local]);
+                }
+            }
+            // Without prediction the session waits for the late inputs
+            if (!predicts() && !complete(_frames[_simulated + 1]))
+                break;
+            _accumulator -= _timestep;
+            simulate();
+        }
+
+        if (!_outgoing.inputs.empty()) {
+            _callbacks.send(_outgoing);
+            _outgoing.inputs.clear();
+        }
+    }
+
+    void lockstep_session::receive(PlayerID player, const lockstep_input& message)
+    {
+        if (player >= RTYPE_PLAYER_COUNT || player == _local
+            || !(_players & (1 << player)))
+            return;
+
+        for (std::size_t i = 0; i < message.inputs.size(); ++i) {
+            const lockstep_tick_t t = message.tick + i;
+
+            if (t <= _confirmed)
+                continue;
+            frame& f = _frames[t];
+            if (f.known & (1 << player))
+                continue;
+            f.inputs[player] = message.inputs[i];
+            f.known |= 1 << player;
+            if (f.simulated && f.used[player] != message.inputs[i])
+                _rollback = true;
+        }
+        confirm();
+    }
+
+    void lockstep_session::remove_player(PlayerID player)
+    {
+        if (player >= RTYPE_PLAYER_COUNT || !(_players & (1 << player)))
+            return;
+        _players &= ~(1 << player);
+        // The ticks simulated with an input of it are simulated again with 0
+        for (const auto& it : _frames)
+            if (it.second.simulated && it.second.used[player] != 0)
+                _rollback = true;
+        confirm();
+    }
+
+}
+}
@@ -0,0 +1,308 @@
+#include "RServer/Feed/Reliability.hpp"
+
+#include <spdlog/spdlog.h>
+
+namespace rtype {
+namespace net {
+
+    delivery delivery_of(message_code code)
+    {
+        switch (code) {
+        case message_code::UPDATE_ENEMY_DESTROYED:
+        case message_code::UPDATE_PLAYER_DESTROYED:
+        case message_code::UPDATE_SCROLL:
+            return delivery::reliable_ordered;
+        case message_code::SYNC_PLAYER:
+        case message_code::SYNC_SRAND:
+        case message_code::LOCKSTEP_INPUT:
+        case message_code::STATE_CHECKSUM:
+            return delivery::reliable_unordered;
+        case message_code::UPDATE_PLAYER:
+            return delivery::unreliable_unordered;
+        default:
+            return delivery::unreliable_sequenced;
+        }
+    }
+
+    void feed_header::write(Serializer& s) const
+    {
+        s << sequence << ack << ack_bits << static_cast<Byte>(mode)
+          << channel_sequence << tick;
+    }
+
+    void feed_header::from(const Byte* data, const BufferSizeType size)
+    {
+        Serializer s(data, std::min(size, SIZE));
+        Byte m = 0;
+
+        s >> sequence >> ack >> ack_bits >> m >> channel_sequence >> tick;
+        if (m >= static_cast<Byte>(delivery::count))
+            throw std::runtime_error("Invalid feed delivery");
+        mode = static_cast<delivery>(m);
+    }
+
+    feed_header reliable_endpoint::next_header(delivery mode)
+    {
+        feed_header header;
+
+        header.sequence = _local_sequence++;
+        header.ack = _remote_sequence;
+        header.ack_bits = _received_bits;
+        header.mode = mode;
+        header.tick = _clock ? _clock->tick() : 0;
+        _ack_pending = false;
+        _last_sent = clock::now();
+        return header;
+    }
+
+    feed_header reliable_endpoint::send(
+        delivery mode, const Byte* data, BufferSizeType size)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        feed_header header = next_header(mode);
+
+        if (mode != delivery::ack_only) {
+            header.channel_sequence
+                = _channel_sequences[static_cast<std::size_t>(mode)]++;
+            _link.on_sent(header.sequence, feed_header::SIZE + size, _last_sent);
+        } else {
+            _link.on_untracked(feed_header::SIZE);
+        }
+        if (mode == delivery::reliable_ordered
+            || mode == delivery::reliable_unordered) {
+            _pending.push_back({ mode, header.channel_sequence,
+                std::vector<Byte>(data, data + size), { header.sequence },
+                _last_sent });
+        }
+        return header;
+    }
+
+    feed_header reliable_endpoint::send(const Byte* data, BufferSizeType size)
+    {
+        const delivery mode = size ? delivery_of(static_cast<message_code>(data[0]))
+                                   : delivery::ack_only;
+        return send(mode, data, size);
+    }
+
+    void reliable_endpoint::on_acked(feed_sequence_t sequence)
+    {
+        auto it = std::find_if(_pending.begin(), _pending.end(),
+            [sequence](const pending_message& m) {
+                return std::find(m.sequences.begin(), m.sequences.end(), sequence)
+                    != m.sequences.end();
+            });
+        if (it != _pending.end())
+            _pending.erase(it);
+    }
+
+    void reliable_endpoint::process_acks(const feed_header& header)
+    {
+        if (!_remote_ack_any || sequence_greater_than(header.ack, _remote_ack)) {
+            _remote_ack_any = true;
+            _remote_ack = header.ack;
+            _remote_ack_bits = header.ack_bits;
+        } else if (header.ack == _remote_ack) {
+            _remote_ack_bits |= header.ack_bits;
+        }
+
+        const auto now = clock::now();
+        for (feed_sequence_t i = 0; i <= 32; ++i) {
+            if (i != 0 && !(header.ack_bits & (1u << (i - 1))))
+                continue;
+            const auto sequence = static_cast<feed_sequence_t>(header.ack - i);
+            _link.on_acked(sequence, now);
+            if (!_pending.empty())
+                on_acked(sequence);
+        }
+    }
+
+    bool reliable_endpoint::track_remote_sequence(feed_sequence_t sequence)
+    {
+        if (!_received_any) {
+            _received_any = true;
+            _remote_sequence = sequence;
+            _received_bits = 0;
+            return true;
+        }
+        if (sequence == _remote_sequence)
+            return false;
+        if (sequence_greater_than(sequence, _remote_sequence)) {
+            const feed_sequence_t shift = sequence - _remote_sequence;
+
+            _received_bits = shift > 32 ? 0
+                                        : ((shift == 32 ? 0 : _received_bits << shift)
+                                              | (1u << (shift - 1)));
+            _remote_sequence = sequence;
+            return true;
+        }
+
+        const feed_sequence_t distance = _remote_sequence - sequence;
+        if (distance > 32)
+            return true; // Too old to be tracked but not a known duplicate
+        const uint32_t bit = 1u << (distance - 1);
+        if (_received_bits & bit)
+            return false;
+        _received_bits |= bit;
+        return true;
+    }
+
+    bool reliable_endpoint::track_unordered_sequence(feed_sequence_t sequence)
+    {
+        if (!_unordered_any || sequence_greater_than(sequence, _last_unordered)) {
+            const feed_sequence_t shift = sequence - _last_unordered;
+
+            if (!_unordered_any || shift >= RTYPE_FEED_UNORDERED_WINDOW)
+                _unordered_received.reset();
+            else
+                _unordered_received <<= shift;
+            _unordered_any = true;
+            _unordered_received.set(0);
+            _last_unordered = sequence;
+            return true;
+        }
+
+        const feed_sequence_t distance = _last_unordered - sequence;
+        if (distance >= RTYPE_FEED_UNORDERED_WINDOW
+            || _unordered_received.test(distance))
+            return false;
+        _unordered_received.set(distance);
+        return true;
+    }
+
+    reliable_endpoint::verdict reliable_endpoint::receive(
+        const feed_header& header, const Byte* data, BufferSizeType size)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        process_acks(header);
+        _remote_tick = std::max(_remote_tick, header.tick);
+        if (header.mode == delivery::ack_only)
+            return verdict::drop;
+        _ack_pending = true;
+
+        if (!track_remote_sequence(header.sequence))
+            return verdict::drop;
+
+        switch (header.mode) {
+        case delivery::unreliable_sequenced: {
+            const uint16_t stream = static_cast<uint16_t>(
+                (size > 0 ? data[0] << 8 : 0) | (size > 1 ? data[1] : 0));
+            auto last = _last_sequenced.find(stream);
+
+            if (last != _last_sequenced.end()
+                && !sequence_greater_than(header.channel_sequence, last->second))
+                return verdict::drop;
+            _last_sequenced[stream] = header.channel_sequence;
+            return verdict::deliver;
+        }
+        case delivery::unreliable_unordered:
+            return verdict::deliver;
+        case delivery::reliable_unordered:
+            if (!track_unordered_sequence(header.channel_sequence))
+                return verdict::drop;
+            return verdict::deliver;
+        case delivery::reliable_ordered:
+            return verdict::ordered;
+        default:
+            return verdict::drop;
+        }
+    }
+
+    void reliable_endpoint::update(std::vector<packet>& packets)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto now = clock::now();
+        const auto timeout = std::chrono::milliseconds(RTYPE_FEED_RESEND_MS);
+
+        for (auto it = _pending.begin(); it != _pending.end();) {
+            if (now - it->last_sent < timeout) {
+                ++it;
+                continue;
+            }
+            // The message is kept: skipping an ordered message would stall
+            // the peer, the connection is closed instead
+            if (_lost)
+                break;
+            if (it->sequences.size() >= RTYPE_FEED_MAX_RESEND) {
+                spdlog::warn("reliable_endpoint: Message of code {} was never "
+                             "acked, the peer is lost",
+                    it->payload.empty() ? 0 : static_cast<int>(it->payload[0]));
+                _lost = true;
+                break;
+            }
+            feed_header header = next_header(it->mode);
+            // A resend keeps the sequence of the message in its channel
+            header.channel_sequence = it->channel_sequence;
+            it->sequences.push_back(header.sequence);
+            it->last_sent = now;
+            _link.on_sent(header.sequence,
+                feed_header::SIZE + it->payload.size(), now);
+            packets.push_back({ header, it->payload });
+            ++it;
+        }
+
+        if (_ack_pending
+            && now - _last_sent
+                >= std::chrono::milliseconds(RTYPE_FEED_ACK_DELAY_MS)) {
+            packets.push_back({ next_header(delivery::ack_only), {} });
+            _link.on_untracked(feed_header::SIZE);
+        }
+
+        if (_remote_ack_any)
+            _link.expire(_remote_ack, now);
+        _rate.update(_link, now);
+    }
+
+    link_stats reliable_endpoint::stats() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        return { _link.rtt(), _link.loss(), _link.bandwidth(), _rate.interval() };
+    }
+
+    std::chrono::milliseconds reliable_endpoint::send_interval() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _rate.interval();
+    }
+
+    void reliable_endpoint::set_clock(const clock_sync* clock)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _clock = clock;
+    }
+
+    feed_tick_t reliable_endpoint::remote_tick() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _remote_tick;
+    }
+
+    std::size_t reliable_endpoint::pending() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pending.size();
+    }
+
+    bool reliable_endpoint::lost() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _lost;
+    }
+
+    bool reliable_endpoint::acked(feed_sequence_t sequence) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (!_remote_ack_any)
+            return false;
+        if (sequence == _remote_ack)
+            return true;
+        if (!sequence_greater_than(_remote_ack, sequence))
+            return false;
+        const feed_sequence_t distance = _remote_ack - sequence;
+        return distance <= 32 && (_remote_ack_bits & (1u << (distance - 1)));
+    }
+
+}
+}
@@ -0,0 +1,82 @@
+#include "RServer/Feed/StateHash.hpp"
+#include "RServer/Messages/BitStream.hpp"
+
+namespace rtype {
+namespace net {
+
+    std::vector<Byte> state_checksum::serialize() const
+    {
+        bit_writer w;
+
+        w.write_varint(tick)
+            .write_bits(static_cast<uint32_t>(hash >> 32), 32)
+            .write_bits(static_cast<uint32_t>(hash), 32);
+        return w.data();
+    }
+
+    void state_checksum::from(const Byte* data, const BufferSizeType size)
+    {
+        bit_reader r(data, size);
+
+        tick = static_cast<state_tick_t>(r.read_varint());
+        hash = static_cast<uint64_t>(r.read_bits(32)) << 32;
+        hash |= r.read_bits(32);
+    }
+
+    desync_detector::desync_detector(report_t report)
+        : _report(std::move(report))
+    {
+    }
+
+    void desync_detector::compare(
+        PlayerID player, state_tick_t tick, uint64_t local, uint64_t remote)
+    {
+        if (local == remote || (_first && *_first <= tick))
+            return;
+        _first = tick;
+        if (_report)
+            _report(player, tick);
+    }
+
+    void desync_detector::local(state_tick_t tick, uint64_t hash)
+    {
+        _local[tick] = hash;
+        while (_local.size() > RTYPE_DESYNC_HISTORY)
+            _local.erase(_local.begin());
+
+        auto it = _pending.find(tick);
+        if (it != _pending.end()) {
+            for (PlayerID i = 0; i < RTYPE_PLAYER_COUNT; ++i)
+                if (it->second[i])
+                    compare(i, tick, hash, *it->second[i]);
+            _pending.erase(it);
+        }
+        // Checksums of ticks the local simulation went past never match
+        // one of ours
+        _pending.erase(_pending.begin(), _pending.lower_bound(tick));
+    }
+
+    void desync_detector::remote(PlayerID player, const state_checksum& checksum)
+    {
+        if (player >= RTYPE_PLAYER_COUNT)
+            return;
+
+        auto it = _local.find(checksum.tick);
+        if (it != _local.end()) {
+            compare(player, checksum.tick, it->second, checksum.hash);
+        } else if (_local.empty() || checksum.tick > _local.rbegin()->first) {
+            _pending[checksum.tick][player] = checksum.hash;
+            while (_pending.size() > RTYPE_DESYNC_HISTORY)
+                _pending.erase(std::prev(_pending.end()));
+        }
+    }
+
+    void desync_detector::reset()
+    {
+        _local.clear();
+        _pending.clear();
+        _first.reset();
+    }
+
+}
+}
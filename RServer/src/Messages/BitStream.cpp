@@ -0,0 +1,94 @@
+#include "RServer/Messages/BitStream.hpp"
+
+namespace rtype {
+namespace net {
+
+    bit_writer& bit_writer::write_bits(uint32_t value, unsigned count)
+    {
+        assert(count <= 32);
+        for (unsigned i = count; i > 0; --i) {
+            if (_bits % 8 == 0)
+                _data.push_back(0);
+            if ((value >> (i - 1)) & 1)
+                _data.back() |= static_cast<Byte>(0x80 >> (_bits % 8));
+            ++_bits;
+        }
+        return *this;
+    }
+
+    bit_writer& bit_writer::write_bool(bool value)
+    {
+        return write_bits(value ? 1 : 0, 1);
+    }
+
+    bit_writer& bit_writer::write_varint(uint64_t value)
+    {
+        do {
+            write_bits(static_cast<uint32_t>(value & 0x7F), 7);
+            value >>= 7;
+            write_bool(value != 0);
+        } while (value);
+        return *this;
+    }
+
+    bit_writer& bit_writer::write_signed_varint(int64_t value)
+    {
+        const uint64_t zigzag = (static_cast<uint64_t>(value) << 1)
+            ^ static_cast<uint64_t>(value >> 63);
+
+        return write_varint(zigzag);
+    }
+
+    bit_writer& bit_writer::align()
+    {
+        _bits = _data.size() * 8;
+        return *this;
+    }
+
+    uint32_t bit_reader::read_bits(unsigned count)
+    {
+        uint32_t value = 0;
+
+        assert(count <= 32);
+        if (remaining_bits() < count)
+            throw std::runtime_error("Cannot extract data");
+        for (unsigned i = 0; i < count; ++i, ++_bits) {
+            value <<= 1;
+            value |= (_data[_bits / 8] >> (7 - _bits % 8)) & 1;
+        }
+        return value;
+    }
+
+    bool bit_reader::read_bool() { return read_bits(1) != 0; }
+
+    uint64_t bit_reader::read_varint()
+    {
+        uint64_t value = 0;
+        unsigned shift = 0;
+        bool more = true;
+
+        while (more) {
+            if (shift >= 64)
+                throw std::runtime_error("Invalid varint");
+            value |= static_cast<uint64_t>(read_bits(7)) << shift;
+            shift += 7;
+            more = read_bool();
+        }
+        return value;
+    }
+
+    int64_t bit_reader::read_signed_varint()
+    {
+        const uint64_t zigzag = read_varint();
+
+        return static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    }
+
+    bit_reader& bit_reader::align()
+    {
+        _bits = std::min<std::size_t>((_bits + 7) / 8 * 8, _size * 8);
+        return *this;
+    }
+
+}
+}
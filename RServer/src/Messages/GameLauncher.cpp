@@ -3,33 +3,37 @@
 namespace rtype {
 namespace net {
 
-    GameLauncher::GameLauncher(int32_t seed, bool yes)
+    GameLauncher::GameLauncher(int32_t seed, bool yes, Byte lockstep_delay)
         : Message(message_code::LAUNCH_GAME_REP)
         , _seed(seed)
         , _yes(yes)
+        , _lockstep_delay(lockstep_delay)
     {}
 
     void GameLauncher::from(const Byte* data, const BufferSizeType size)
     {
         Serializer s(data, size);
-        s >> _message_code >> _yes >> _seed;
+        s >> _message_code >> _yes >> _seed >> _lockstep_delay;
     }
 
     std::vector<Byte> GameLauncher::serialize() const
     {
         Serializer s;
-        s << _message_code << _yes << _seed;
+        s << _message_code << _yes << _seed << _lockstep_delay;
         return s.data;
     }
 
     BufferSizeType GameLauncher::size() const
     {
-        return sizeof(_message_code) + sizeof(_yes) + sizeof(_seed);
+        return sizeof(_message_code) + sizeof(_yes) + sizeof(_seed)
+            + sizeof(_lockstep_delay);
     }
 
     bool GameLauncher::yes() const { return static_cast<bool>(_yes); }
 
     int32_t GameLauncher::seed() const { return _seed; }
 
+    Byte GameLauncher::lockstep_delay() const { return _lockstep_delay; }
+
 }
 }
@@ -51,7 +51,13 @@ namespace net {
             { message_code::UPDATE_PLAYER, message_type::UPDATE_MESSAGE },
             { message_code::UPDATE_ENEMY_DESTROYED, message_type::UPDATE_MESSAGE },
             { message_code::UPDATE_PLAYER_DESTROYED, message_type::UPDATE_MESSAGE },
-            { message_code::UPDATE_SCROLL, message_type::UPDATE_MESSAGE }
+            { message_code::UPDATE_SCROLL, message_type::UPDATE_MESSAGE },
+
+            // Lockstep messages
+            { message_code::LOCKSTEP_INPUT, message_type::UPDATE_MESSAGE },
+            { message_code::STATE_CHECKSUM, message_type::UPDATE_MESSAGE },
+            { message_code::CLOCK_PING, message_type::UPDATE_MESSAGE },
+            { message_code::CLOCK_PONG, message_type::UPDATE_MESSAGE }
         };
 
     message_type message_code_to_type(const message_code& code)
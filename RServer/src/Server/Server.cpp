@@ -259,18 +259,22 @@ namespace net {
 
     udp_server::message_info::message_info(
         udp::endpoint sender, udp_buffer_t&& buffer, BufferSizeType size)
-        : base_message_info(std::move(buffer), size)
+        : base_message_info(std::move(buffer),
+            size > RTYPE_UDP_MESSAGE_HEADER ? size - RTYPE_UDP_MESSAGE_HEADER
+                                            : 0)
         , _sender(sender)
+        , _received_at(clock_sync::clock::now())
     {
         Byte* pos = this->buffer.c_array();
         Serializer serializer(pos, size);
 
         serializer >> _magic >> _sender_id;
-        _size = buffer.size();
+        _size = size;
         if (_magic != RTYPE_MAGIC_NUMBER) {
             spdlog::error("udp_server: Invalid magic number received");
             throw std::runtime_error("Invalid magic number received");
         }
+        _header.from(serializer.data.data(), serializer.data.size());
     }
 
     Byte* udp_server::message_info::msg() const { return _msg; }
@@ -288,14 +292,35 @@ namespace net {
 
     ClientID udp_server::message_info::sender_id() { return _sender_id; }
 
-    udp_server::shared_message_info_t udp_server::new_message(
-        ClientID sender, const void* data, BufferSizeType size)
+    const feed_header& udp_server::message_info::header() const
+    {
+        return _header;
+    }
+
+    const Byte* udp_server::message_info::payload() const
+    {
+        return buffer.data() + RTYPE_UDP_MESSAGE_HEADER;
+    }
+
+    BufferSizeType udp_server::message_info::payload_size() const
+    {
+        return base_message_info::size;
+    }
+
+    clock_sync::clock::time_point udp_server::message_info::received_at() const
+    {
+        return _received_at;
+    }
+
+    udp_server::shared_message_info_t udp_server::new_message(ClientID sender,
+        const feed_header& header, const void* data, BufferSizeType size)
     {
         static const MagicNumber magic = RTYPE_MAGIC_NUMBER;
 
         Serializer s;
 
         s << magic << sender;
+        header.write(s);
         s.add_bytes(reinterpret_cast<const Byte*>(data), size);
 
         assert(s.data.size() < udp_buffer_t::size() - RTYPE_UDP_MESSAGE_HEADER);
@@ -311,17 +336,10 @@ namespace net {
     }
 
     udp_server::shared_message_info_t udp_server::new_message(
-        ClientID sender, const IMessage& msg)
+        ClientID sender, const feed_header& header, const IMessage& msg)
     {
         auto buffer = msg.serialize();
-        return new_message(sender, buffer.data(), buffer.size());
-    }
-
-    udp_server::shared_message_info_t udp_server::new_message(
-        ClientID sender, const std::string& s)
-    {
-        return new_message(
-            sender, reinterpret_cast<const void*>(s.c_str()), s.size());
+        return new_message(sender, header, buffer.data(), buffer.size());
     }
 
     void udp_server::handle_receive_from(const boost::system::error_code& error,
@@ -395,6 +413,8 @@ namespace net {
         start_receive();
     }
 
+    const clock_sync& udp_server::clock() const { return _clock; }
+
     remote_client::remote_client()
         : _main_channel(nullptr)
         , _feed_channel(nullptr)
@@ -415,6 +435,7 @@ namespace net {
     {
         _feed_channel = &feed_channel;
         _feed_endpoint = feed_endpoint;
+        _feed_reliability.set_clock(&feed_channel.clock());
     }
 
     void remote_client::send_main(tcp_connection::shared_message_info_t msg)
@@ -461,26 +482,41 @@ namespace net {
         }
     }
 
-    void remote_client::send_feed(const std::string& s)
+    void remote_client::send_feed_packet(
+        const feed_header& header, const void* data, BufferSizeType size)
+    {
+        send_feed(udp_server::new_message(_main_id, header, data, size));
+    }
+
+    feed_header remote_client::send_feed(const std::string& s)
     {
-        send_feed(udp_server::new_message(_main_id, s));
+        return send_feed(s.c_str(), s.size());
     }
 
-    void remote_client::send_feed(const void* data, BufferSizeType size)
+    feed_header remote_client::send_feed(const void* data, BufferSizeType size)
     {
-        send_feed(udp_server::new_message(_main_id, data, size));
+        const Byte* bytes = reinterpret_cast<const Byte*>(data);
+        const feed_header header = _feed_reliability.send(bytes, size);
+
+        send_feed_packet(header, data, size);
+        return header;
     }
 
-    void remote_client::send_feed(const rtype::net::IMessage& message)
+    feed_header remote_client::send_feed(const rtype::net::IMessage& message)
     {
         auto bytes = message.serialize();
-        send_feed(bytes.data(), bytes.size());
+        return send_feed(bytes.data(), bytes.size());
     }
 
-    void remote_client::send_feed(rtype::net::IMessage& message)
+    feed_header remote_client::send_feed(rtype::net::IMessage& message)
     {
         auto bytes = message.serialize();
-        send_feed(bytes.data(), bytes.size());
+        return send_feed(bytes.data(), bytes.size());
+    }
+
+    const reliable_endpoint& remote_client::feed_reliability() const
+    {
+        return _feed_reliability;
     }
 
     ClientID remote_client::id() const { return _main_id; }
@@ -490,6 +526,42 @@ namespace net {
         return _feed_endpoint;
     }
 
+    void remote_client::receive_feed(udp_server::shared_message_info_t msg,
+        std::vector<udp_server::shared_message_info_t>& ready)
+    {
+        switch (_feed_reliability.receive(
+            msg->header(), msg->payload(), msg->payload_size())) {
+        case reliable_endpoint::verdict::deliver:
+            ready.push_back(msg);
+            break;
+        case reliable_endpoint::verdict::ordered:
+            _feed_ordered.push(msg->header().channel_sequence, msg, ready);
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool remote_client::update_feed()
+    {
+        if (_feed_channel == nullptr)
+            return true;
+
+        std::vector<reliable_endpoint::packet> packets;
+
+        _feed_reliability.update(packets);
+        for (auto& packet : packets) {
+            send_feed_packet(
+                packet.header, packet.payload.data(), packet.payload.size());
+        }
+        if (_feed_reliability.lost()) {
+            spdlog::warn("remote_client: Feed of client {} lost", _main_id);
+            _feed_channel = nullptr;
+            return false;
+        }
+        return true;
+    }
+
     server::server(PortType tcp_port, PortType udp_port, Bool authenticate)
         : _io_context(boost::asio::io_context())
         , _tcp_server(new tcp_server(_io_context, tcp_port))
@@ -639,21 +711,86 @@ namespace net {
             msg->sender_id());
         event.client = get_client(msg->sender_id());
         event.client->init_feed_channel(*_udp_server, msg->sender());
+        // Only keeps the acks, the feed init itself is handled here
+        std::vector<udp_server::shared_message_info_t> ignored;
+        event.client->receive_feed(msg, ignored);
         event.client->send_feed(FeedInitReply(RTYPE_FEED_INIT_TOKEN));
         return false;
     }
 
+    bool server::on_udp_clock_ping(
+        event& event, udp_server::shared_message_info_t& msg)
+    {
+        event.client = get_client(msg->sender_id());
+        // Only keeps the acks, the ping is answered here
+        std::vector<udp_server::shared_message_info_t> ignored;
+        event.client->receive_feed(msg, ignored);
+        if (ignored.empty())
+            return false;
+
+        auto update = parse_message<UpdateMessage>(msg->to_vec());
+        if (update == nullptr)
+            return false;
+        clock_ping ping;
+        ping.from(update->data().data(), update->data().size());
+        event.client->send_feed(
+            UpdateMessage(msg->sender_id(),
+                _udp_server->clock().pong(ping, msg->received_at()),
+                message_code::CLOCK_PONG));
+        return false;
+    }
+
     bool server::poll_udp(event& event, udp_server::shared_message_info_t& msg)
     {
         if (_authenticate && msg->code() == message_code::FEED_INIT) {
             return on_udp_feed_init(event, msg);
-        } else {
-            return on_udp_event_message(event, msg);
+        }
+        if (msg->code() == message_code::CLOCK_PING) {
+            return on_udp_clock_ping(event, msg);
+        }
+
+        std::vector<udp_server::shared_message_info_t> ready;
+
+        get_client(msg->sender_id())->receive_feed(msg, ready);
+        _feed_ready.insert(_feed_ready.end(), ready.begin(), ready.end());
+        if (_feed_ready.empty())
+            return false;
+        auto next = _feed_ready.front();
+        _feed_ready.pop_front();
+        return on_udp_event_message(event, next);
+    }
+
+    void server::update_feed()
+    {
+        const auto now = reliable_endpoint::clock::now();
+
+        if (now - _last_feed_update
+            < std::chrono::milliseconds(RTYPE_FEED_UPDATE_MS))
+            return;
+        _last_feed_update = now;
+        for (auto& client : _clients) {
+            if (!client.second->update_feed())
+                _feed_lost.push_back(client.second);
         }
     }
 
     bool server::poll(event& event)
     {
+        update_feed();
+
+        if (!_feed_lost.empty()) {
+            event.type = rtype::net::server::event_type::Disconnect;
+            event.client = _feed_lost.front();
+            _feed_lost.pop_front();
+            return true;
+        }
+
+        if (!_feed_ready.empty()) {
+            auto next = _feed_ready.front();
+            _feed_ready.pop_front();
+            return on_udp_event_message(event, next);
+        }
+
         {
             tcp_event tcp_event;
             if (_tcp_server->poll(tcp_event)) {
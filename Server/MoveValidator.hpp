@@ -0,0 +1,132 @@
+#pragma once
+
+#include "PileAA/external/HelifeWasTaken/Silva"
+#include "RServer/Messages/Types.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <optional>
+
+// Speed of a player in pixels per second (see rtype::game::APlayer)
+#ifndef RTYPE_MOVE_SPEED_X
+#define RTYPE_MOVE_SPEED_X 200
+#endif
+
+#ifndef RTYPE_MOVE_SPEED_Y
+#define RTYPE_MOVE_SPEED_Y 150
+#endif
+
+// Time (in milliseconds) a state may arrive late because of the jitter of
+// the network, the move allowed grows with it
+#ifndef RTYPE_MOVE_SLACK_MS
+#define RTYPE_MOVE_SLACK_MS 100
+#endif
+
+// Distance (in pixels) a move may exceed, the positions are quantized on
+// the feed
+#ifndef RTYPE_MOVE_QUANTUM
+#define RTYPE_MOVE_QUANTUM 4
+#endif
+
+/**
+ * @brief Checks the moves of the players of a started room, run by the
+ *        server when "authoritative" is set in Server.conf
+ *
+ *        Every player is an entity of a headless registry whose position is
+ *        only moved by the states the player sends, as far as its speed
+ *        allows since the previous one. A state that goes further is cut
+ *        and must be sent back to its player as a correction
+ *        It only validates moves: the maps, the enemies, the bullets and
+ *        the collisions are still simulated by the clients
+ *        The first state of a player after a reset is taken as is, the room
+ *        resets the validator when a game or a map starts
+ */
+class MoveValidator {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // Position of a player relative to the scroll
+    struct Body {
+        double x = 0;
+        double y = 0;
+    };
+
+    // When the position of a player was last moved
+    struct Motion {
+        clock::time_point last;
+    };
+
+    MoveValidator() { reset(); }
+
+    ~MoveValidator() = default;
+
+    /**
+     * @brief Moves a player to the state it sent, or as close as it can go
+     *
+     * @param player The player that sent the state
+     * @param state The state, its position is corrected if it is too far
+     * @param now The reception time of the state
+     * @return true if the state was corrected
+     */
+    bool validate(rtype::net::PlayerID player, rtype::net::player_state& state,
+        clock::time_point now = clock::now())
+    {
+        if (player >= RTYPE_PLAYER_COUNT)
+            return false;
+        if (!_players[player]) {
+            auto e = _world.spawn_entity();
+            _world.emplace<Body>(e, double(state.pos.x), double(state.pos.y))
+                .emplace<Motion>(e, now);
+            _players[player] = e;
+            return false;
+        }
+
+        auto& body = _world.get_component<Body>(*_players[player]);
+        auto& motion = _world.get_component<Motion>(*_players[player]);
+        const double dt = std::chrono::duration<double>(now - motion.last).count()
+            + RTYPE_MOVE_SLACK_MS / 1000.0;
+        const double reach_x = RTYPE_MOVE_SPEED_X * dt + RTYPE_MOVE_QUANTUM;
+        const double reach_y = RTYPE_MOVE_SPEED_Y * dt + RTYPE_MOVE_QUANTUM;
+
+        motion.last = now;
+        body.x = std::clamp<double>(state.pos.x, body.x - reach_x, body.x + reach_x);
+        body.y = std::clamp<double>(state.pos.y, body.y - reach_y, body.y + reach_y);
+        if (body.x == state.pos.x && body.y == state.pos.y)
+            return false;
+
+        spdlog::warn("MoveValidator: Player {} moved too far ({}, {}), "
+                     "corrected to ({}, {})",
+            player, state.pos.x, state.pos.y, body.x, body.y);
+        state.pos.x = static_cast<uint16_t>(body.x);
+        state.pos.y = static_cast<uint8_t>(body.y);
+        return true;
+    }
+
+    void remove(rtype::net::PlayerID player)
+    {
+        if (player >= RTYPE_PLAYER_COUNT || !_players[player])
+            return;
+        _world.kill_entity(*_players[player]);
+        _world.update();
+        _players[player].reset();
+    }
+
+    /**
+     * @brief Forgets every player (a new game or a new map starts, the
+     *        players are put back to their spawn)
+     */
+    void reset()
+    {
+        _world = hl::silva::registry();
+        _world.register_component<Body, Motion>();
+        _players = {};
+    }
+
+private:
+    hl::silva::registry _world;
+    std::array<std::optional<hl::silva::registry::entity_t>, RTYPE_PLAYER_COUNT>
+        _players;
+};
@@ -1,7 +1,12 @@
+#include "RServer/Feed/InputHistory.hpp"
+#include "RServer/Feed/Interest.hpp"
+#include "RServer/Feed/Snapshot.hpp"
 #include "RServer/Messages/Types.hpp"
 #include "RServer/Server/Server.hpp"
+#include "MoveValidator.hpp"
 #include <algorithm>
 #include <functional>
+#include <optional>
 #include <unordered_map>
 
 class Room {
@@ -18,9 +23,55 @@ private:
 
     using IMessage = rtype::net::IMessage;
 
+    using player_decoder = rtype::net::snapshot_decoder<rtype::net::player_state>;
+    using player_encoder = rtype::net::snapshot_encoder<rtype::net::player_state>;
+
+    // Snapshots received from each player (by player id)
+    std::array<player_decoder, RTYPE_PLAYER_COUNT> _player_snapshots;
+
+    // Snapshots relayed to each client (by client then by player id),
+    // every client has its own acked baselines
+    std::unordered_map<rtype::net::ClientID,
+        std::array<player_encoder, RTYPE_PLAYER_COUNT>>
+        _player_relays;
+
+    // Input frames received from each player and the ones relayed with its
+    // snapshots (by player id)
+    std::array<rtype::net::input_receiver, RTYPE_PLAYER_COUNT> _player_inputs;
+    std::array<rtype::net::input_history, RTYPE_PLAYER_COUNT> _relayed_inputs;
+
+    using relay_clock = rtype::net::reliable_endpoint::clock;
+
+    // States waiting for the send interval of each client (by client then
+    // by player id), only the latest state of a player is kept
+    std::unordered_map<rtype::net::ClientID,
+        std::array<std::optional<rtype::net::player_state>, RTYPE_PLAYER_COUNT>>
+        _pending_relays;
+    std::unordered_map<rtype::net::ClientID, relay_clock::time_point> _last_relays;
+
+    // Latest state of each player (by player id), the focus of its client
+    std::array<std::optional<rtype::net::player_state>, RTYPE_PLAYER_COUNT>
+        _player_states;
+
+    // Which states each client gets first under its budget, and the input
+    // and health bits last relayed to it (by client then by player id)
+    std::unordered_map<rtype::net::ClientID, rtype::net::interest_manager>
+        _interests;
+    std::unordered_map<rtype::net::ClientID,
+        std::array<std::optional<uint8_t>, RTYPE_PLAYER_COUNT>>
+        _relayed_data;
+
+    // Only set when the server is authoritative
+    std::unique_ptr<MoveValidator> _validator;
+
+    // Last scroll relayed for the host, it goes back when a map starts
+    int32_t _scroll = 0;
+
 public:
-    Room(rtype::net::server& server, rtype::net::ClientID client)
+    Room(rtype::net::server& server, rtype::net::ClientID client,
+        bool authoritative = false)
         : _server(server)
+        , _validator(authoritative ? std::make_unique<MoveValidator>() : nullptr)
     {
         _client_to_index[client] = 0;
         _connected_players[0] = true;
@@ -52,6 +103,25 @@ public:
 
         _connected_players[_client_to_index.at(client)] = false;
         _client_to_index.erase(client);
+        _player_snapshots[index].reset();
+        _player_inputs[index].reset();
+        _relayed_inputs[index].reset();
+        _player_relays.erase(client);
+        for (auto& relay : _player_relays)
+            relay.second[index].reset();
+        _pending_relays.erase(client);
+        _last_relays.erase(client);
+        for (auto& pending : _pending_relays)
+            pending.second[index].reset();
+        _player_states[index].reset();
+        _interests.erase(client);
+        for (auto& interest : _interests)
+            interest.second.forget(index);
+        _relayed_data.erase(client);
+        for (auto& relayed : _relayed_data)
+            relayed.second[index].reset();
+        if (_validator)
+            _validator->remove(index);
 
         if (index == _hostID) {
             _hostID = RTYPE_INVALID_PLAYER_ID;
@@ -86,6 +156,9 @@ public:
             return false;
         }
         _started = true;
+        _scroll = 0;
+        if (_validator)
+            _validator->reset();
         return true;
     }
 
@@ -124,6 +197,167 @@ public:
         }
     }
 
+    /**
+     * @brief Relays the snapshot of a player to the other clients
+     *        The snapshot is decoded then encoded again against the baseline
+     *        acked by each client, nothing is sent to a client that already
+     *        acked the same state
+     *        The last input frames of the player are relayed with it
+     *        A client gets the states at the send interval of its
+     *        connection (see reliable_endpoint::send_interval), the states
+     *        received in between replace the pending one
+     *        Under the budget of the client the states that matter the most
+     *        to it go first (see interest_manager), the others wait
+     *        When the room is authoritative a state that moved too far is
+     *        corrected, relayed corrected and sent back to its player
+     */
+    void feed_player_update(const rtype::net::IMessage& message,
+        rtype::net::ClientID sender)
+    {
+        const auto* update = rtype::net::parse_message<rtype::net::UpdateMessage>(message);
+        const rtype::net::PlayerID sid = get_client_player_id(sender);
+        rtype::net::player_update received;
+        rtype::net::player_state state;
+
+        if (update == nullptr || sid == RTYPE_INVALID_PLAYER_ID)
+            return;
+        received.from(update->data().data(), update->data().size());
+        for (const auto& frame : _player_inputs[sid].receive(received.inputs))
+            _relayed_inputs[sid].push(frame.tick, frame.bits);
+        // Without its baseline the snapshot is dropped, the next full state
+        // of the sender will fix it (an outdated one is only kept as a
+        // baseline)
+        if (!_player_snapshots[sid].decode(received.snapshot, state))
+            return;
+        if (_validator && _validator->validate(sid, state))
+            send_correction(sender, sid, state);
+        _player_states[sid] = state;
+        for (auto& client : _client_to_index) {
+            if (client.first == sender)
+                continue;
+            _pending_relays[client.first][sid] = state;
+            relay_pending(client.first);
+        }
+    }
+
+    /**
+     * @brief Relays the scroll of the host to the other clients
+     *        A scroll lower than the last one means a new map started, the
+     *        players are back to their spawn so the moves are checked again
+     *        from there (see MoveValidator::reset)
+     */
+    void feed_scroll_update(const rtype::net::IMessage& message,
+        rtype::net::ClientID sender)
+    {
+        const auto* update = rtype::net::parse_message<rtype::net::UpdateMessage>(message);
+
+        feed_broadcast(message, sender);
+        if (update == nullptr || get_client_player_id(sender) != _hostID)
+            return;
+        rtype::net::bit_reader reader(update->data().data(), update->data().size());
+        const auto scroll = rtype::net::bits::varint().read<int32_t>(reader);
+
+        if (_validator && scroll < _scroll)
+            _validator->reset();
+        _scroll = scroll;
+    }
+
+    /**
+     * @brief Sends the pending states of the clients whose send interval
+     *        elapsed
+     */
+    void update_feed()
+    {
+        for (auto& client : _client_to_index)
+            relay_pending(client.first);
+    }
+
+private:
+    // The client of the player reconciles its prediction with the state
+    // (an UPDATE_PLAYER of its own player)
+    void send_correction(rtype::net::ClientID client, rtype::net::PlayerID sid,
+        const rtype::net::player_state& state)
+    {
+        auto remote = _server.get_client(client);
+        auto& encoder = _player_relays[client][sid];
+        const auto header = remote->send_feed(rtype::net::UpdateMessage(sid,
+            rtype::net::player_update(
+                encoder.encode(state, remote->feed_reliability()), {}),
+            rtype::net::message_code::UPDATE_PLAYER));
+
+        encoder.sent(header.sequence);
+    }
+
+    // The positions of the players are relative to the scroll, every client
+    // sees the whole window around its own player
+    rtype::net::interest_view view_of(rtype::net::ClientID client) const
+    {
+        rtype::net::interest_view view { { 0, 0 },
+            { RTYPE_PLAYER_STATE_MAX_X, RTYPE_PLAYER_STATE_MAX_Y }, std::nullopt };
+        const rtype::net::PlayerID sid = get_client_player_id(client);
+
+        if (sid != RTYPE_INVALID_PLAYER_ID && _player_states[sid])
+            view.focus = rtype::net::interest_point {
+                double(_player_states[sid]->pos.x), double(_player_states[sid]->pos.y) };
+        return view;
+    }
+
+    void relay_pending(rtype::net::ClientID client)
+    {
+        auto pending = _pending_relays.find(client);
+
+        if (pending == _pending_relays.end())
+            return;
+
+        auto remote = _server.get_client(client);
+        const auto now = relay_clock::now();
+
+        if (now - _last_relays[client]
+            < remote->feed_reliability().send_interval())
+            return;
+
+        auto& interest = _interests[client];
+        auto& relayed = _relayed_data[client];
+        std::vector<rtype::net::interest_candidate> candidates;
+
+        for (rtype::net::PlayerID sid = 0; sid < RTYPE_PLAYER_COUNT; ++sid) {
+            auto& state = pending->second[sid];
+            if (!state)
+                continue;
+            if (_player_relays[client][sid].up_to_date(*state, remote->feed_reliability())) {
+                state.reset();
+                continue;
+            }
+            // A shot or a hit changes the input and health bits
+            candidates.push_back({ sid,
+                { double(state->pos.x), double(state->pos.y) },
+                relayed[sid] == state->data ? 1.0 : RTYPE_INTEREST_EVENT_RELEVANCE });
+        }
+
+        interest.refill(now);
+        for (const rtype::net::interest_id_t sid : interest.rank(view_of(client), candidates)) {
+            if (!interest.has_budget())
+                break;
+            auto& state = pending->second[sid];
+            auto& encoder = _player_relays[client][sid];
+            const rtype::net::UpdateMessage update(sid,
+                rtype::net::player_update(
+                    encoder.encode(*state, remote->feed_reliability()),
+                    _relayed_inputs[sid].frames()),
+                rtype::net::message_code::UPDATE_PLAYER);
+            const auto buffer = update.serialize();
+            const auto header = remote->send_feed(buffer.data(), buffer.size());
+
+            encoder.sent(header.sequence);
+            interest.sent(sid, buffer.size() + rtype::net::feed_header::SIZE);
+            relayed[sid] = state->data;
+            state.reset();
+            _last_relays[client] = now;
+        }
+    }
+
+public:
+
     const std::unordered_map<rtype::net::ClientID, rtype::net::PlayerID>&
     get_clients() const
     {
@@ -7,9 +7,18 @@ private:
 
     std::unordered_map<rtype::net::ClientID, std::string> _client_to_room_id;
 
+    // Input delay of the lockstep mode (0 if disabled)
+    const rtype::net::Byte _lockstep_delay;
+
+    // Whether the rooms check the moves of the players (see MoveValidator)
+    const bool _authoritative;
+
 public:
-    RoomManager(rtype::net::server& server)
+    RoomManager(rtype::net::server& server, rtype::net::Byte lockstep_delay = 0,
+        bool authoritative = false)
         : _server(server)
+        , _lockstep_delay(lockstep_delay)
+        , _authoritative(authoritative)
     {
     }
 
@@ -22,7 +31,7 @@ public:
         while (_rooms.find(roomID) != _rooms.end()) {
             roomID = rtype::net::token::generate_token();
         }
-        _rooms[roomID] = std::make_unique<Room>(_server, client);
+        _rooms[roomID] = std::make_unique<Room>(_server, client, _authoritative);
         _client_to_room_id[client] = roomID;
 
         _server.get_client(client)->send_main(rtype::net::CreateRoomReply(roomID));
@@ -88,13 +97,19 @@ public:
         return nullptr;
     }
 
+    void update()
+    {
+        for (auto& room : _rooms)
+            room.second->update_feed();
+    }
+
     void launchGame(rtype::net::ClientID client)
     {
         auto it = _client_to_room_id.find(client);
         if (it != _client_to_room_id.end()
             && _rooms.at(it->second)->launchGame()) {
             _rooms.at(it->second)->main_broadcast(
-                rtype::net::GameLauncher(std::time(nullptr), true)
+                rtype::net::GameLauncher(std::time(nullptr), true, _lockstep_delay)
             );
         } else {
             _server.get_client(client)->send_main(
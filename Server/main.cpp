@@ -112,9 +112,13 @@ private:
             RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::ROOM_CLIENT_DISCONNECT),
             RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::SYNC_PLAYER),
             RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::UPDATE_PLAYER),
-            RTYPE_SERVER_MAIN_DEFAULT_BROADCAST_MESSAGE(rtype::net::message_code::UPDATE_ENEMY_DESTROYED),
-            RTYPE_SERVER_MAIN_DEFAULT_BROADCAST_MESSAGE(rtype::net::message_code::UPDATE_PLAYER_DESTROYED),
-            RTYPE_SERVER_MAIN_DEFAULT_BROADCAST_MESSAGE(rtype::net::message_code::UPDATE_SCROLL)
+            RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::UPDATE_ENEMY_DESTROYED),
+            RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::UPDATE_PLAYER_DESTROYED),
+            RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::UPDATE_SCROLL),
+            RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::LOCKSTEP_INPUT),
+            RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::STATE_CHECKSUM),
+            RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::CLOCK_PING),
+            RTYPE_SERVER_MAIN_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::CLOCK_PONG)
         };
 
     std::unordered_map<rtype::net::message_code,
@@ -141,10 +145,26 @@ private:
             RTYPE_SERVER_FEED_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::ROOM_CLIENT_DISCONNECT),
 
             RTYPE_SERVER_FEED_DEFAULT_BROADCAST_MESSAGE(rtype::net::message_code::SYNC_PLAYER),
-            RTYPE_SERVER_FEED_DEFAULT_BROADCAST_MESSAGE(rtype::net::message_code::UPDATE_PLAYER),
-            RTYPE_SERVER_FEED_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::UPDATE_ENEMY_DESTROYED),
-            RTYPE_SERVER_FEED_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::UPDATE_PLAYER_DESTROYED),
-            RTYPE_SERVER_FEED_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::UPDATE_SCROLL)
+            RTYPE_SERVER_FEED_HANDLE_THIS_MESSAGE(rtype::net::message_code::UPDATE_PLAYER,
+                {
+                    Room* room = this->_roomManager.getRoom(client);
+                    if (room) {
+                        room->feed_player_update(message, client);
+                    }
+                }),
+            RTYPE_SERVER_FEED_DEFAULT_BROADCAST_MESSAGE(rtype::net::message_code::UPDATE_ENEMY_DESTROYED),
+            RTYPE_SERVER_FEED_DEFAULT_BROADCAST_MESSAGE(rtype::net::message_code::UPDATE_PLAYER_DESTROYED),
+            RTYPE_SERVER_FEED_HANDLE_THIS_MESSAGE(rtype::net::message_code::UPDATE_SCROLL,
+                {
+                    Room* room = this->_roomManager.getRoom(client);
+                    if (room) {
+                        room->feed_scroll_update(message, client);
+                    }
+                }),
+            RTYPE_SERVER_FEED_DEFAULT_BROADCAST_MESSAGE(rtype::net::message_code::LOCKSTEP_INPUT),
+            RTYPE_SERVER_FEED_DEFAULT_BROADCAST_MESSAGE(rtype::net::message_code::STATE_CHECKSUM),
+            RTYPE_SERVER_FEED_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::CLOCK_PING),
+            RTYPE_SERVER_FEED_SHOULD_NOT_HANDLE_THIS_CODE(rtype::net::message_code::CLOCK_PONG)
         };
 
     std::unordered_map<rtype::net::server::event_type,
@@ -195,9 +215,11 @@ private:
 public:
     RTypeServer(const rtype::net::PortType tcp_port,
         const rtype::net::PortType udp_port,
-        const rtype::net::Bool authentificate)
+        const rtype::net::Bool authentificate,
+        const rtype::net::Byte lockstep_delay = 0,
+        const bool authoritative = false)
         : _server(tcp_port, udp_port, authentificate)
-        , _roomManager(_server)
+        , _roomManager(_server, lockstep_delay, authoritative)
     {
     }
 
@@ -211,6 +233,7 @@ public:
                 while (_server.poll(event)) {
                     _events_types_handler.at(event.type)(event);
                 }
+                _roomManager.update();
             } catch (const std::exception& e) {
                 spdlog::critical("RTypeServer: std::exception caught: {}", e.what());
             } catch (...) {
@@ -223,6 +246,7 @@ public:
 #include <PileAA/external/nlohmann/json.hpp>
 #include <fstream>
 #include <filesystem>
+#include <limits>
 #include <RServer/AsciiTitle.hpp>
 
 int main(int argc, char **argv)
@@ -245,7 +269,19 @@ int main(int argc, char **argv)
 
         ifs >> json;
 
-        RTypeServer(json["tcp_port"], json["udp_port"], json["authentificate"])
+        // Rooms exchange only the inputs of the players when it is set
+        // (input delay in ticks, sent to the clients on a byte), with
+        // "authoritative" they check the moves of the players
+        const int lockstep_delay = json.value("lockstep_input_delay", 0);
+        if (lockstep_delay < 0
+            || lockstep_delay > std::numeric_limits<rtype::net::Byte>::max()) {
+            spdlog::critical("lockstep_input_delay must be between 0 and {} in ../Server.conf (got {})",
+                std::numeric_limits<rtype::net::Byte>::max(), lockstep_delay);
+            return 1;
+        }
+        RTypeServer(json["tcp_port"], json["udp_port"], json["authentificate"],
+            static_cast<rtype::net::Byte>(lockstep_delay),
+            json.value("authoritative", false))
             .run();
         ifs.close();
     } catch (...) {